@@ -1,43 +1,314 @@
+#if defined(SERVIDOR) || defined(CACHE_RESULTADOS) || defined(TRADUCAO_ANTECIPADA)
+// fopencookie, com que o trace de cada pedido do servidor é enviado pela conexão, copy_file_range, com que
+// a cache de resultados copia os arquivos de saída, e dladdr, com que a compilação do simulador é identificada
+#define _GNU_SOURCE
+#endif
+
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <ctype.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Interface pública da libpoxim (a linha de comando é um cliente dela)
+#include "poxim.h"
+
+#ifdef TRACE_ASSINCRONO
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#endif
+
+#ifdef JIT_X86_64
+#include <stddef.h>
+#endif
+
+#ifdef TRADUCAO_ANTECIPADA
+#include <dlfcn.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+// Ambiente repassado ao compilador das traduções
+extern char **environ;
+#endif
+
+#ifdef EXECUCAO_EM_LOTE
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef EXECUCAO_VETORIAL
+#include <immintrin.h>
+#endif
+
+#ifdef SERVIDOR
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#ifdef CACHE_RESULTADOS
+#include <unistd.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
 
 // Tipo interrupção
 typedef struct interrupcao {
-    uint8_t prioridade;
     uint32_t cr;
     uint32_t ipc;
-    struct interrupcao *prox;
-    struct interrupcao *ant;
 } Interrupcao;
 
-// Lista de interrupções agendadas
-Interrupcao *interrupcoesAgendadas = NULL;
-
-// 32 registradores inicializados com 0
-uint32_t R[32] = {0};
-
-// Output do terminal
-char *outputTerminal = NULL;
-
 // Define o tamanho máximo base do output
 const int TAMANHO_BASE_OUTPUT = 300;
 
-// Tamanho atual do output
-int tamanhoOutput = 0;
-
-// Memória indexada de 4 em 4 bytes
-uint32_t *MEM = NULL;
-
-// Ponteiros para os arquivos de entrada e saída
-FILE *entrada = NULL;
-FILE *saida = NULL;
-
-// Ponteiro para arquivo de debug
-FILE *debug = NULL;
+// Palavras da memória: todo o espaço de endereçamento de 32 bits (4 GiB). A memória é apenas reservada,
+// e o sistema só aloca cada página quando ela é tocada pela primeira vez
+const uint32_t PALAVRAS_MEMORIA = 1u << 30;
+
+// Cache de pré-decodificação em páginas de 1024 instruções (4KiB de código), alocadas na primeira decodificação
+// de uma instrução da página. Com o limite de páginas alocadas (32MiB de entradas), elas são descartadas e
+// decodificadas de novo, e um programa que percorre toda a memória não faz o simulador crescer sem limite
+const uint32_t BITS_PAGINA_INSTRUCOES = 10;
+const uint32_t MAXIMO_PAGINAS_INSTRUCOES = 1024;
+
+// Palavras do início da memória (os 32KiB da memória original) com as entradas da cache sempre alocadas e
+// contíguas. As tabelas de blocos cobrem as mesmas palavras, e o código nativo indexa a cache diretamente
+const uint32_t PALAVRAS_CACHE_CONTIGUA = 32 * 1024 / 4;
+
+// Cada palavra fica na ordem de bytes do hospedeiro, e os bytes e meias-palavras da máquina simulada são big-endian
+// dentro dela. Em um hospedeiro little-endian, o byte de endereço a fica na posição a ^ 3 da memória vista como
+// bytes, e a meia-palavra de endereço a na posição (a >> 1) ^ 1 da memória vista como meias-palavras
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const uint32_t TROCA_BYTE = 0;
+const uint32_t TROCA_MEIA_PALAVRA = 0;
+#else
+const uint32_t TROCA_BYTE = 3;
+const uint32_t TROCA_MEIA_PALAVRA = 1;
+#endif
+
+// Operações reconhecidas pelo decodificador
+typedef enum operacao {
+    OP_MOV,
+    OP_MOVS,
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_SLL,
+    OP_MULS,
+    OP_SLA,
+    OP_DIV,
+    OP_SRL,
+    OP_DIVS,
+    OP_SRA,
+    OP_INVALIDA,
+    OP_CMP,
+    OP_AND,
+    OP_OR,
+    OP_NOT,
+    OP_XOR,
+    OP_PUSH,
+    OP_POP,
+    OP_ADDI,
+    OP_SUBI,
+    OP_MULI,
+    OP_DIVI,
+    OP_MODI,
+    OP_CMPI,
+    OP_L8,
+    OP_L16,
+    OP_L32,
+    OP_S8,
+    OP_S16,
+    OP_S32,
+    OP_CALLF,
+    OP_RET,
+    OP_RETI,
+    OP_CBR,
+    OP_SBR,
+    OP_BAE,
+    OP_BAT,
+    OP_BBE,
+    OP_BBT,
+    OP_BEQ,
+    OP_BGE,
+    OP_BGT,
+    OP_BIV,
+    OP_BLE,
+    OP_BLT,
+    OP_BNE,
+    OP_BNI,
+    OP_BNZ,
+    OP_BUN,
+    OP_BZD,
+    OP_CALLS,
+    OP_INT,
+    TOTAL_OPERACOES
+} Operacao;
+
+// Tipo instrução pré-decodificada (campos extraídos do IR uma única vez)
+typedef struct instrucao_decodificada {
+    void (*executar)(Poxim *, struct instrucao_decodificada *);
+    Operacao operacao;
+    uint32_t ir;
+    int32_t imediato;
+    uint32_t alvo;
+    uint8_t z;
+    uint8_t x;
+    uint8_t y;
+    uint8_t l;
+    uint8_t v;
+    uint8_t usaSR;
+    uint8_t valida;
+} InstrucaoDecodificada;
+
+#if defined(JIT_X86_64) && !defined(BLOCOS_BASICOS)
+#error "JIT_X86_64 compila os blocos básicos e depende de BLOCOS_BASICOS"
+#endif
+
+#if defined(PERFIL_SUPERINSTRUCOES) && (defined(SUPERINSTRUCOES) || defined(BLOCOS_BASICOS) || defined(DESPACHO_ENCADEADO))
+#error "PERFIL_SUPERINSTRUCOES mede o laço principal, sem superinstruções nem outro motor de execução"
+#endif
+
+#if defined(SUPERINSTRUCOES) && (defined(BLOCOS_BASICOS) || defined(DESPACHO_ENCADEADO))
+#error "SUPERINSTRUCOES são despachadas pelo laço principal"
+#endif
+
+#if defined(TRADUCAO_ANTECIPADA) && !defined(BLOCOS_BASICOS)
+#error "TRADUCAO_ANTECIPADA traduz os blocos básicos e depende de BLOCOS_BASICOS"
+#endif
+
+#if defined(CACHE_RESULTADOS) && defined(PERFIL_SUPERINSTRUCOES)
+#error "CACHE_RESULTADOS pularia as execuções que o perfil deve medir"
+#endif
+
+#if defined(EXECUCAO_VETORIAL) && !defined(EXECUCAO_EM_LOTE)
+#error "EXECUCAO_VETORIAL executa juntos os trabalhos do lote e depende de EXECUCAO_EM_LOTE"
+#endif
+
+#if defined(EXECUCAO_VETORIAL) && (!defined(__x86_64__) || !defined(__GNUC__))
+#error "EXECUCAO_VETORIAL usa AVX2 (x86-64) e depende do GCC/Clang"
+#endif
+
+#ifdef BLOCOS_BASICOS
+#ifdef DESPACHO_ENCADEADO
+#error "BLOCOS_BASICOS e DESPACHO_ENCADEADO são motores de execução alternativos"
+#endif
+
+// Bloco básico traduzido: instruções decodificadas em sequência, do PC inicial até o primeiro desvio,
+// chamada, retorno, int ou instrução inválida, e os blocos seguintes já encontrados
+typedef struct bloco {
+    uint32_t inicio;
+    uint32_t geracao;
+    uint32_t quantidade;
+    // Sucessores encadeados: [0] para a instrução após o bloco, [1] para o último destino de desvio
+    struct bloco *sucessores[2];
+#if defined(JIT_X86_64) || defined(TRADUCAO_ANTECIPADA)
+    // Execuções desde a tradução e o código nativo compilado ou traduzido antecipadamente (NULL se não houver)
+    uint32_t execucoes;
+    uint32_t (*codigoNativo)(Poxim *);
+#endif
+    InstrucaoDecodificada instrucoes[];
+} Bloco;
+
+const int TAMANHO_MAXIMO_BLOCO = 32;
+
+// Entradas da tabela de blocos, indexada pelo PC inicial (PC >> 2): as mesmas palavras de PALAVRAS_CACHE_CONTIGUA
+const int ENTRADAS_TABELA_BLOCOS = 32 * 1024 / 4;
+
+#ifdef JIT_X86_64
+#if !defined(__x86_64__) || !defined(__GNUC__)
+#error "JIT_X86_64 gera código de máquina x86-64 (System V) e depende do GCC/Clang"
+#endif
+
+// Blocos executados esta quantidade de vezes são compilados para código nativo
+const int LIMIAR_JIT = 16;
+
+// Área executável preenchida sequencialmente; cheia, os blocos ainda não compilados continuam interpretados
+const int CAPACIDADE_CODIGO_JIT = 16 * 1024 * 1024;
+
+// Espaço livre exigido para compilar um bloco de tamanho máximo
+const int RESERVA_BLOCO_JIT = 8 * 1024;
+#endif
+#endif
+
+#ifdef PERFIL_SUPERINSTRUCOES
+// Contagem de uma sequência de 2 a 4 operações: a chave guarda o tamanho (bits 24 a 26) e as operações (6 bits cada)
+typedef struct sequencia_perfil {
+    uint32_t chave;
+    uint64_t contagem;
+} SequenciaPerfil;
+
+const int ENTRADAS_PERFIL = 1 << 16;
+
+// Superinstruções geradas a partir dos perfis
+const int MAXIMO_SUPERINSTRUCOES = 16;
+#endif
+
+// Mnemônicos das operações, como aparecem no trace
+const char *MNEMONICOS[TOTAL_OPERACOES] = {
+    [OP_MOV] = "mov", [OP_MOVS] = "movs", [OP_ADD] = "add", [OP_SUB] = "sub",
+    [OP_MUL] = "mul", [OP_SLL] = "sll", [OP_MULS] = "muls", [OP_SLA] = "sla",
+    [OP_DIV] = "div", [OP_SRL] = "srl", [OP_DIVS] = "divs", [OP_SRA] = "sra",
+    [OP_INVALIDA] = "", [OP_CMP] = "cmp", [OP_AND] = "and", [OP_OR] = "or",
+    [OP_NOT] = "not", [OP_XOR] = "xor", [OP_PUSH] = "push", [OP_POP] = "pop",
+    [OP_ADDI] = "addi", [OP_SUBI] = "subi", [OP_MULI] = "muli", [OP_DIVI] = "divi",
+    [OP_MODI] = "modi", [OP_CMPI] = "cmpi", [OP_L8] = "l8", [OP_L16] = "l16",
+    [OP_L32] = "l32", [OP_S8] = "s8", [OP_S16] = "s16", [OP_S32] = "s32",
+    [OP_CALLF] = "call", [OP_RET] = "ret", [OP_RETI] = "reti", [OP_CBR] = "cbr",
+    [OP_SBR] = "sbr", [OP_BAE] = "bae", [OP_BAT] = "bat", [OP_BBE] = "bbe",
+    [OP_BBT] = "bbt", [OP_BEQ] = "beq", [OP_BGE] = "bge", [OP_BGT] = "bgt",
+    [OP_BIV] = "biv", [OP_BLE] = "ble", [OP_BLT] = "blt", [OP_BNE] = "bne",
+    [OP_BNI] = "bni", [OP_BNZ] = "bnz", [OP_BUN] = "bun", [OP_BZD] = "bzd",
+    [OP_CALLS] = "call", [OP_INT] = "int"
+};
+
+// Operador exibido na coluna de valores das operações lógicas e aritméticas
+const char OPERADORES[TOTAL_OPERACOES] = {
+    [OP_ADD] = '+', [OP_SUB] = '-', [OP_AND] = '&', [OP_OR] = '|', [OP_XOR] = '^',
+    [OP_ADDI] = '+', [OP_SUBI] = '-', [OP_MULI] = '*', [OP_DIVI] = '/', [OP_MODI] = '%'
+};
+
+// Tipos de registro do trace: a execução de uma instrução, as mensagens de interrupção e o terminal
+typedef enum tipo_passo {
+    PASSO_INSTRUCAO,
+    PASSO_INSTRUCAO_INVALIDA,
+    PASSO_INTERRUPCAO_SOFTWARE,
+    PASSO_INTERRUPCAO_HARDWARE,
+    PASSO_TERMINAL,
+    // Último registro do trace binário, com a quantidade de registros anteriores (valores[0] e valores[1])
+    PASSO_FIM
+} TipoPasso;
+
+// Registro de tamanho fixo de um passo do trace; o significado dos valores depende da operação
+// (ver renderizar_valores) e o texto é produzido a partir dele, durante a execução ou depois
+typedef struct passo_trace {
+    uint32_t tipo;
+    uint32_t pc;
+    uint32_t ir;
+    uint32_t valores[6];
+} PassoTrace;
 
 // Flags do SR
 typedef enum flag {
@@ -60,2728 +331,7954 @@ typedef enum registrador_especial {
     SR
 } RegistradorEspecial;
 
-// Variável que determina se o programa está em execução
-uint8_t emExecucao = 1;
-
-// Contador do WatchDog
-int contador;
+// Operações cujas flags ZN, SN, OV e CY são calculadas apenas quando o SR é lido
+typedef enum operacao_flags {
+    FLAGS_MATERIALIZADAS,
+    FLAGS_ADD,
+    FLAGS_SUB,
+    FLAGS_CMP,
+    FLAGS_ADDI,
+    FLAGS_SUBI,
+    FLAGS_CMPI,
+    FLAGS_LOGICA,
+    FLAGS_MUL,
+    FLAGS_MULS,
+    FLAGS_MULI,
+    FLAGS_DESLOCAMENTO,
+    FLAGS_DESLOCAMENTO_ARITMETICO
+} OperacaoFlags;
+
+// Flags do SR escritas por cada operação
+const uint32_t FLAGS_AFETADAS[] = {
+    [FLAGS_MATERIALIZADAS] = 0,
+    [FLAGS_ADD] = (0b1 << ZN) | (0b1 << SN) | (0b1 << OV) | (0b1 << CY),
+    [FLAGS_SUB] = (0b1 << ZN) | (0b1 << SN) | (0b1 << OV) | (0b1 << CY),
+    [FLAGS_CMP] = (0b1 << ZN) | (0b1 << SN) | (0b1 << OV) | (0b1 << CY),
+    [FLAGS_ADDI] = (0b1 << ZN) | (0b1 << SN) | (0b1 << OV) | (0b1 << CY),
+    [FLAGS_SUBI] = (0b1 << ZN) | (0b1 << SN) | (0b1 << OV) | (0b1 << CY),
+    [FLAGS_CMPI] = (0b1 << ZN) | (0b1 << SN) | (0b1 << OV) | (0b1 << CY),
+    [FLAGS_LOGICA] = (0b1 << ZN) | (0b1 << SN),
+    [FLAGS_MUL] = (0b1 << ZN) | (0b1 << CY),
+    [FLAGS_MULS] = (0b1 << ZN) | (0b1 << OV),
+    [FLAGS_MULI] = (0b1 << ZN) | (0b1 << OV),
+    [FLAGS_DESLOCAMENTO] = (0b1 << ZN) | (0b1 << CY),
+    [FLAGS_DESLOCAMENTO_ARITMETICO] = (0b1 << ZN) | (0b1 << OV)
+};
+
+// Última operação que alterou as flags, com os índices e os valores dos operandos logo após a execução
+typedef struct flags_pendentes {
+    OperacaoFlags operacao;
+    uint8_t z;
+    uint8_t x;
+    uint8_t y;
+    uint8_t l;
+    uint32_t rz;
+    uint32_t rx;
+    uint32_t ry;
+    uint32_t rl;
+    int32_t imediato;
+} FlagsPendentes;
+
+#if defined(CACHE_RESULTADOS) || defined(TRADUCAO_ANTECIPADA)
+// Constantes do SHA-256 (FIPS 180-4): o estado inicial e as constantes de cada rodada
+const uint32_t ESTADO_INICIAL_SHA256[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+const uint32_t RODADAS_SHA256[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+// Resumo SHA-256 em andamento: o estado, os bytes já resumidos e o bloco de 64 bytes ainda incompleto
+typedef struct sha256 {
+    uint32_t estado[8];
+    uint64_t tamanho;
+    uint8_t bloco[64];
+} Sha256;
+
+// Identificação da compilação do simulador, parte do resumo dos resultados e das traduções antecipadas: o SHA-256
+// do arquivo com o código do simulador (o executável ou a libpoxim compartilhada). Resultados e traduções de outra
+// compilação não são reaproveitados, e sem a identificação (arquivo ilegível) as caches não são usadas
+uint8_t identificacaoSimulador[32];
+uint8_t simuladorIdentificado;
+pthread_once_t identificacaoCalculada = PTHREAD_ONCE_INIT;
+#endif
+
+#ifdef CACHE_RESULTADOS
+
+// Limite padrão do tamanho da cache de resultados (--cache-size=<MiB>)
+const uint64_t LIMITE_PADRAO_RESULTADOS = 256;
+
+// Resultado guardado na cache, ordenado pelo último uso para o descarte
+typedef struct resultado_em_cache {
+    char nome[96];
+    uint64_t tamanho;
+    struct timespec usado;
+} ResultadoEmCache;
+#endif
+
+#ifdef TRADUCAO_ANTECIPADA
+// Compilador das traduções quando $CC não estiver definida: o que compilou o simulador (o Makefile informa o seu CC)
+#ifndef COMPILADOR_TRADUCAO
+#ifdef __clang__
+#define COMPILADOR_TRADUCAO "clang"
+#else
+#define COMPILADOR_TRADUCAO "gcc"
+#endif
+#endif
+
+// Palavras do comando do compilador ($CC pode ter opções, como "ccache gcc" ou "gcc -m64")
+const int MAXIMO_ARGUMENTOS_COMPILADOR = 32;
+
+// Estado e funções da máquina usados pelo código traduzido. É o primeiro campo da máquina: as funções
+// traduzidas recebem a máquina e a leem como o seu vínculo
+typedef struct vinculo_traducao {
+    uint32_t *R;
+    uint32_t *MEM;
+    uint8_t *palavrasEmBlocos;
+    uint32_t *geracaoBlocos;
+    void (*registrar_flags)(Poxim *, OperacaoFlags, uint8_t, uint8_t, uint8_t, uint8_t, int32_t);
+    void (*executar_instrucao)(Poxim *, uint32_t);
+    void (*invalidar_instrucao_decodificada)(Poxim *, uint32_t);
+} VinculoTraducao;
+#endif
+
+// Modos de trace: o completo formata cada instrução executada; os demais não
+// formatam nada durante a execução e emitem apenas o terminal (e o resumo final, no desligado)
+typedef enum modo_trace {
+    TRACE_DESLIGADO,
+    TRACE_TERMINAL,
+    TRACE_COMPLETO
+} ModoTrace;
+
+
+// Início do arquivo de trace binário: assinatura e tamanho de cada registro
+const char ASSINATURA_TRACE_BINARIO[8] = "POXIMTRC";
+
+// Imagem binária (gerada com --pack): a assinatura seguida das palavras na ordem de bytes da máquina
+const char ASSINATURA_IMAGEM[8] = "POXIMIMG";
+
+// Imagem lida de um arquivo. As palavras de uma imagem binária são usadas diretamente do mapeamento do
+// arquivo (mapeamento diferente de NULL); as de um .hex ficam em um vetor alocado
+typedef struct imagem {
+    uint32_t *palavras;
+    uint32_t quantidade;
+    void *mapeamento;
+    size_t tamanhoMapeamento;
+} Imagem;
+
+// Eventos verificados ao fim de uma instrução, na ordem em que são tratados
+typedef enum evento {
+    EVENTO_INTERRUPCOES,
+    EVENTO_WATCHDOG,
+    EVENTO_FPU_INICIO,
+    EVENTO_FPU_CONCLUSAO,
+    EVENTO_PAUSA,
+    TOTAL_EVENTOS
+} Evento;
+
+const uint64_t EVENTO_INATIVO = UINT64_MAX;
+
+// Valor inicial dos resumos de imagens (FNV-1a de 64 bits)
+const uint64_t RESUMO_INICIAL = 0xCBF29CE484222325;
 
-// Registrador do temporizador (Watchdog)
-uint32_t watchdog;
 
 typedef union {
     float f;
     uint32_t u;
 } RegistradorFPU;
 
-// Registradores do FPU
-RegistradorFPU fpuX;
-RegistradorFPU fpuY;
-RegistradorFPU fpuZ;
-
-// Variáveis auxiliares do FPU
-uint8_t fpuX_IEEE754 = 0;
-uint8_t fpuY_IEEE754 = 0;
-uint8_t fpuZ_IEEE754 = 1;
-uint8_t fpuControle = 0;
-int fpuContador = -1;
-uint8_t fpuPrioridade;
-
-// Cadeia de caracteres da instrução
-char instrucao[30] = {0};
-
-// Strings de identificação de registradores
-char registradorZ[5], registradorX[5], registradorY[5], registradorL[5], registradorV[5], registradorW[5];
-
-// Variáveis auxiliares
-uint32_t pcAtual;
+// Tamanho do buffer próprio do trace, escrito no arquivo de saída em blocos
+const int TAMANHO_BUFFER_TRACE = 64 * 1024;
+
+#ifdef TRACE_ASSINCRONO
+// Capacidade da fila de registros entre o interpretador e a thread do trace
+const uint32_t CAPACIDADE_FILA_TRACE = 8192;
+#endif
+
+// Nomes dos registradores na coluna da instrução e na dos valores
+const char *NOMES_REGISTRADORES[32] = {
+    "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "r11", "r12",
+    "r13", "r14", "r15", "r16", "r17", "r18", "r19", "r20", "r21", "r22", "r23", "r24", "r25",
+    "cr", "ipc", "ir", "pc", "sp", "sr"
+};
+
+const char *NOMES_REGISTRADORES_MAIUSCULOS[32] = {
+    "R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7", "R8", "R9", "R10", "R11", "R12",
+    "R13", "R14", "R15", "R16", "R17", "R18", "R19", "R20", "R21", "R22", "R23", "R24", "R25",
+    "CR", "IPC", "IR", "PC", "SP", "SR"
+};
+
+// Início já formatado de uma linha do trace ("0x...:\t", instrução completada até 25 caracteres e o tab),
+// que depende apenas do PC e da palavra da instrução, junto da instrução decodificada usada pela coluna de valores
+typedef struct desmontagem {
+    uint32_t pc;
+    uint32_t ir;
+    uint8_t valida;
+    uint8_t tamanho;
+    char texto[64];
+    InstrucaoDecodificada decodificada;
+} Desmontagem;
+
+// Entradas da cache de desmontagem, indexada pelo PC (PC >> 2)
+const int ENTRADAS_CACHE_DESMONTAGEM = 32 * 1024 / 4;
+
+// Callbacks de um dispositivo registrados com poxim_set_device
+typedef struct dispositivo {
+    PoximDeviceRead ler;
+    PoximDeviceWrite escrever;
+    void *contexto;
+} Dispositivo;
+
+// Região do barramento de dispositivos, de inicio a fim (inclusive). Os tratadores recebem o endereço e o
+// tamanho do acesso (1 ou 4 bytes) e devolvem 0 se não o tratam, e o acesso segue então para a memória
+typedef struct regiao_dispositivo {
+    uint32_t inicio;
+    uint32_t fim;
+    uint8_t (*ler)(Poxim *, uint32_t, uint8_t, uint32_t *);
+    uint8_t (*escrever)(Poxim *, uint32_t, uint8_t, uint32_t);
+} RegiaoDispositivo;
+
+// Regiões que cabem no barramento de uma máquina (define, pois dimensiona o vetor em struct poxim)
+#define MAXIMO_REGIOES_BARRAMENTO 8
+
+// Estado completo de uma máquina simulada: nenhuma função do simulador guarda estado fora dela, então
+// máquinas independentes podem ser executadas no mesmo processo, cada uma em sua thread
+struct poxim {
+#ifdef TRADUCAO_ANTECIPADA
+    // Primeiro campo, lido pelas funções traduzidas a partir do ponteiro da máquina
+    VinculoTraducao vinculoTraducao;
+#endif
+
+    // 32 registradores inicializados com 0
+    uint32_t R[32];
+
+    // Memória indexada de 4 em 4 bytes
+    uint32_t *MEM;
+
+    // Cache de instruções pré-decodificadas, com uma página por 4KiB de código (PC >> 12). As páginas do início
+    // da memória, cobertas pelas tabelas de blocos, ficam contíguas em cacheInstrucoes, indexada por PC >> 2, e
+    // nunca são descartadas; as demais são alocadas sob demanda, com seus índices em paginasAlocadas
+    InstrucaoDecodificada *cacheInstrucoes;
+    InstrucaoDecodificada **paginasInstrucoes;
+    uint32_t *paginasAlocadas;
+    uint32_t totalPaginasAlocadas;
+
+    // Instrução em um PC desalinhado, decodificada a cada execução: o cache é indexado pela palavra (PC >> 2), mas
+    // os destinos dos desvios são relativos ao PC real, então a entrada do PC alinhado não pode ser reaproveitada
+    InstrucaoDecodificada instrucaoAvulsa;
+
+    // Última operação que alterou as flags, ainda não calculadas no SR
+    FlagsPendentes flagsPendentes;
+
+    // Variável que determina se o programa está em execução
+    uint8_t emExecucao;
+
+    // Imagem carregada (a simulação começou) e execução interrompida pelo limite de poxim_run, não pelo programa
+    uint8_t inicializada;
+    uint8_t pausada;
+
+    ModoTrace modoTrace;
+
+    // Trace completo gravado como registros binários (--trace=binary), renderizados depois com --render, e os
+    // registros gravados até aqui, conferidos pelo registro de fim
+    uint8_t traceBinario;
+    uint64_t registrosTrace;
+
+    // Variáveis auxiliares
+    uint32_t pcAtual;
+
+    // Quantidade de instruções executadas, usada nas medições de desempenho
+    uint64_t instrucoesExecutadas;
+
+    // Número da instrução em que cada evento deve ser tratado e o menor deles
+    uint64_t eventos[TOTAL_EVENTOS];
+    uint64_t proximoEvento;
+
+    // Interrupções pendentes, uma por prioridade (1 a 4): cada prioridade tem uma única origem, com um único CR,
+    // então a duplicada de mesmo (cr, prioridade) ocupa a mesma posição e substitui a anterior
+    Interrupcao tabelaInterrupcoes[5];
+
+    // Mapa de bits das prioridades pendentes (bit n para a prioridade n); a de menor número é tratada primeiro
+    uint8_t interrupcoesAgendadas;
+
+    // Registrador do temporizador (Watchdog)
+    uint32_t watchdog;
+
+    // Registradores do FPU
+    RegistradorFPU fpuX;
+    RegistradorFPU fpuY;
+    RegistradorFPU fpuZ;
+
+    // Variáveis auxiliares do FPU
+    uint8_t fpuX_IEEE754;
+    uint8_t fpuY_IEEE754;
+    uint8_t fpuZ_IEEE754;
+    uint8_t fpuControle;
+    int fpuContador;
+    uint8_t fpuPrioridade;
+
+    // Output do terminal e o seu tamanho atual
+    char *outputTerminal;
+    int tamanhoOutput;
+
+    // Contadores de interrupções para o resumo emitido sem o trace completo
+    uint32_t totalInstrucoesInvalidas;
+    uint32_t totalInterrupcoesSoftware;
+    uint32_t totalInterrupcoesHardware[5];
+
+    // Ponteiros para os arquivos de saída e debug (NULL se não houver)
+    FILE *saida;
+    FILE *debug;
+
+    // Dispositivos mapeados em memória interceptados pelo programa que usa a biblioteca
+    Dispositivo dispositivos[POXIM_TOTAL_DEVICES];
+
+    // Barramento de dispositivos: as regiões registradas e a janela de endereços que contém todas elas, verificada
+    // com uma única comparação (endereço - início <= extensão) pelos acessos à memória de l8, l32, s8 e s32. l16 e
+    // s16 não passam pelo barramento: como no simulador original, nenhum dispositivo tem registradores de 2 bytes
+    // e esses acessos vão sempre para a memória
+    RegiaoDispositivo barramento[MAXIMO_REGIOES_BARRAMENTO];
+    int totalRegioes;
+    uint32_t inicioBarramento;
+    uint32_t extensaoBarramento;
+
+    // Buffer próprio do trace e a posição em que começa a coluna da instrução (completada com espaços até 25 caracteres)
+    char *bufferTrace;
+    int tamanhoTrace;
+    int inicioColunaInstrucao;
+
+    // Dígitos hexadecimais de cada byte, em pares
+    char tabelaHexadecimal[256][2];
+
+    // Cache de desmontagem, usada tanto na execução quanto pelo renderizador. Cada entrada é validada
+    // pelo PC e pelo IR, o que cobre código reescrito em execução
+    Desmontagem *cacheDesmontagem;
+
+    // Entrada para PCs além da cache de desmontagem, formatada a cada uso
+    Desmontagem desmontagemAvulsa;
+
+#ifdef BLOCOS_BASICOS
+    // Blocos indexados pelo PC inicial (PC >> 2), alocados na primeira tradução e reaproveitados nas seguintes
+    Bloco **tabelaBlocos;
+
+    // Palavras da memória que fazem parte de algum bloco: uma escrita nelas descarta todos os blocos,
+    // avançando a geração com que cada bloco foi traduzido
+    uint8_t *palavrasEmBlocos;
+    uint32_t geracaoBlocos;
+#endif
+
+#ifdef JIT_X86_64
+    // Área executável desta máquina: o código compilado embute os endereços do seu estado
+    uint8_t *codigoJit;
+    uint8_t *cursorJit;
+
+    // Epílogo comum a todos os blocos compilados (restaura os registradores e retorna), no início da área
+    uint8_t *epilogoJit;
+#endif
+
+#ifdef TRADUCAO_ANTECIPADA
+    // Diretório das traduções (--aot=<diretório>), com o fonte e a biblioteca de cada imagem
+    char *diretorioTraducao;
+    void *bibliotecaTraducao;
+
+    // Funções traduzidas indexadas pelo PC inicial do bloco (PC >> 2) e a imagem a partir da qual foram geradas
+    uint32_t (**traducoesAntecipadas)(Poxim *);
+    uint32_t *imagemCarregada;
+#endif
+
+#ifdef CACHE_RESULTADOS
+    // Diretório da cache de resultados (--cache=<diretório>), o limite do seu tamanho em bytes e se foi
+    // ignorada (--no-cache)
+    char *diretorioResultados;
+    uint64_t limiteResultados;
+    uint8_t cacheIgnorada;
+
+    // Resultado ausente da cache: o resumo da imagem (SHA-256 em hexadecimal) e o arquivo de saída, guardado ao
+    // fim da simulação
+    char resumoResultado[65];
+    const char *caminhoResultado;
+#endif
+
+#ifdef PERFIL_SUPERINSTRUCOES
+    // Perfil da execução (--profile=<arquivo>) e as últimas operações executadas em endereços consecutivos
+    SequenciaPerfil *perfil;
+    char *arquivoPerfil;
+    uint32_t historicoPerfil;
+    uint32_t tamanhoHistoricoPerfil;
+    uint32_t pcAnteriorPerfil;
+#endif
+
+#ifdef TRACE_ASSINCRONO
+    // Fila circular de registros do trace entre o interpretador (único produtor) e a thread que os
+    // formata e escreve (única consumidora). Os índices só crescem; a posição é o índice módulo a capacidade
+    PassoTrace *filaTrace;
+
+    // Cada índice em sua própria linha de cache, para que produtor e consumidor não disputem a mesma
+    _Alignas(64) _Atomic uint32_t inicioFilaTrace;
+    _Alignas(64) _Atomic uint32_t fimFilaTrace;
+
+    // Última leitura do início da fila feita pelo produtor: só é relida quando a fila parece cheia
+    _Alignas(64) uint32_t inicioFilaProdutor;
+
+    // Sinaliza à thread do trace que não haverá novos registros
+    _Atomic uint8_t traceEncerrado;
+
+    pthread_t threadTrace;
+#endif
+};
+
+#ifdef EXECUCAO_EM_LOTE
+// Par (entrada, saída) do manifesto do lote e o resultado da sua execução
+typedef struct trabalho_lote {
+    char *entrada;
+    char *saida;
+    uint64_t instrucoes;
+    struct timespec inicio;
+    double segundos;
+    uint8_t concluido;
+} TrabalhoLote;
+
+// Fila de cada trabalhador: um intervalo [inicio, fim) de índices do manifesto. O dono consome pelo início;
+// um trabalhador sem trabalhos rouba a metade final da fila de outro. Cada fila em sua própria linha de cache
+typedef struct fila_lote {
+    _Alignas(64) pthread_mutex_t trava;
+    uint32_t inicio;
+    uint32_t fim;
+} FilaLote;
+
+// Lote em execução, compartilhado pelos trabalhadores. As opções do simulador são as da linha de comando,
+// interpretadas novamente por cada trabalho em sua própria máquina
+typedef struct lote {
+    TrabalhoLote *trabalhos;
+    uint32_t totalTrabalhos;
+    FilaLote *filas;
+    int totalTrabalhadores;
+    int argc;
+    char **argv;
+} Lote;
+
+typedef struct trabalhador_lote {
+    Lote *lote;
+    int indice;
+} TrabalhadorLote;
+#endif
+
+#ifdef EXECUCAO_VETORIAL
+// Trabalhos do lote executados juntos pelo motor vetorial: um por elemento de 32 bits de um vetor AVX2
+const int PISTAS_VETORIAIS = 8;
+
+// Máquinas executadas em sincronia, uma por pista. Os registradores ficam em estrutura de arrays (R[r] tem o
+// registrador r das 8 pistas), com as flags sempre calculadas no SR; a máquina de cada pista só recebe os
+// registradores e a contagem de instruções quando o tratador executa uma instrução dela
+typedef struct grupo_vetorial {
+    _Alignas(32) uint32_t R[32][8];
+
+    // Instruções executadas por pista desde a última sincronização com a máquina, e quantas ainda podem ser
+    // executadas antes da instrução do próximo evento agendado
+    _Alignas(32) uint32_t executadas[8];
+    _Alignas(32) uint32_t folga[8];
+
+    Poxim *maquinas[8];
+
+    // Pistas com máquinas em execução, uma por bit
+    uint32_t ativas;
+
+    // Palavras já comparadas entre todas as pistas, marcadas com a geração da comparação. A geração avança a
+    // cada escrita na memória (e a cada instrução do tratador, que pode escrever em qualquer endereço). A tabela
+    // é de acesso direto pelo índice da palavra, com o PC de cada entrada para distinguir endereços que colidem
+    uint64_t geracao;
+    uint64_t palavrasIguais[32 * 1024 / 4];
+    uint32_t pcsIguais[32 * 1024 / 4];
+} GrupoVetorial;
+#endif
+
+#ifdef SERVIDOR
+// Protocolo do modo servidor (--serve), em um soquete Unix e na ordem de bytes da máquina. Cada pedido é um
+// cabeçalho seguido das palavras da imagem; uma conexão pode enviar vários pedidos, atendidos em sequência
+typedef struct pedido_servidor {
+    char assinatura[8];
+    uint32_t modoTrace;
+    uint32_t quantidade;
+    uint64_t limite;
+} PedidoServidor;
+
+const char ASSINATURA_PEDIDO_SERVIDOR[8] = "POXIMJOB";
+
+// A resposta é uma sequência de mensagens (tipo, tamanho e conteúdo): o terminal e o trace conforme são
+// produzidos e, por último, o fim ou um erro
+typedef enum tipo_mensagem {
+    MENSAGEM_TERMINAL,
+    MENSAGEM_TRACE,
+    MENSAGEM_FIM,
+    MENSAGEM_ERRO
+} TipoMensagem;
+
+typedef struct mensagem_servidor {
+    uint32_t tipo;
+    uint32_t tamanho;
+} MensagemServidor;
+
+// Conteúdo da mensagem de fim: instruções executadas, se o programa terminou (ou esgotou o limite) e se a
+// máquina, com as instruções decodificadas e os blocos traduzidos, foi reaproveitada de um pedido anterior
+typedef struct fim_servidor {
+    uint64_t instrucoes;
+    uint32_t terminou;
+    uint32_t reaproveitada;
+} FimServidor;
+
+// Instruções executadas entre os envios do terminal acumulado
+const uint64_t FATIA_SERVIDOR = 1 << 20;
+
+const int TAMANHO_TERMINAL_SERVIDOR = 4096;
+
+// Máquinas mantidas após os pedidos para reaproveitamento com a mesma imagem e o mesmo modo de trace
+const int MAQUINAS_EM_ESPERA = 16;
+
+typedef struct maquina_em_espera {
+    Poxim *maquina;
+    uint32_t *imagem;
+    uint32_t quantidade;
+    uint64_t resumo;
+    PoximTrace modo;
+} MaquinaEmEspera;
+
+// Estado do servidor, compartilhado pelos trabalhadores, que aceitam as conexões diretamente do soquete
+typedef struct servidor {
+    int soquete;
+    int argc;
+    char **argv;
+    pthread_mutex_t trava;
+    MaquinaEmEspera *emEspera;
+    int totalEmEspera;
+} Servidor;
+
+// Conexão em atendimento: o terminal é acumulado e enviado em blocos
+typedef struct conexao_servidor {
+    int descritor;
+    uint8_t perdida;
+    char *terminal;
+    uint32_t tamanhoTerminal;
+} ConexaoServidor;
+#endif
 
 // FUNÇÕES DO PROGRAMA
 
 // Funções auxiliares
-char *str_upper(char *);
 int64_t potencia(int, int);
-uint8_t empilhar(uint8_t);
-uint8_t desempilhar(uint8_t);
-void formatar_string_registrador(uint8_t, char *);
-void formatar_string_empilhamento_instrucao(char *, uint8_t, char *);
-void formatar_string_empilhamento_resultado_pt1(char *, uint8_t, uint32_t);
-void formatar_string_empilhamento_resultado_pt2(char *, uint8_t, char *);
-void inicializar_simulador();
-void finalizar_simulador();
-void retornar_instrucao_invalida();
-void ativar_flag(Flag);
-void desativar_flag(Flag);
-uint8_t verificar_flag_setada(Flag);
-void preparar_execucao_ISR();
-void decodificar_instrucao(uint8_t);
-void imprimir_output_terminal();
-void adicionar_caractere_output(char);
-Interrupcao *obter_interrupcao_duplicada(Interrupcao *);
-void remover_interrupcao_agendada(Interrupcao *);
-void agendar_interrupcao(uint8_t, uint32_t, uint32_t);
-void tratar_interrupcao();
-void destruir_interrupcoes_agendadas();
-void executar_watchdog();
-void decodificar_instrucao_fpu(uint8_t);
-void fpu_adicao();
-void fpu_subtracao();
-void fpu_multiplicacao();
-void fpu_divisao();
-void fpu_atribuicao_x();
-void fpu_atribuicao_y();
-void fpu_teto();
-void fpu_piso();
-void fpu_arredondamento();
-void fpu_interrupcao();
-void fpu_preparar_interrupcao(uint8_t, int);
-void executar_logica_fpu();
+uint8_t empilhar(Poxim *, uint8_t);
+uint8_t desempilhar(Poxim *, uint8_t);
+uint8_t interpretar_opcoes(Poxim *, int, char **);
+int renderizar_trace_binario(int, char **);
+#if defined(EXECUCAO_EM_LOTE) || defined(SERVIDOR)
+char **separar_opcoes_paralelas(int, char **, int *, long *);
+#endif
+#ifdef SERVIDOR
+int executar_servidor(int, char **);
+void *executar_trabalhador_servidor(void *);
+void atender_conexao(Servidor *, ConexaoServidor *);
+uint8_t atender_pedido(Servidor *, ConexaoServidor *);
+Poxim *obter_maquina_servidor(Servidor *, const uint32_t *, uint32_t, uint64_t, PoximTrace, uint8_t *);
+void devolver_maquina_servidor(Servidor *, Poxim *, const uint32_t *, uint32_t, uint64_t, PoximTrace);
+void reiniciar_simulador(Poxim *, const uint32_t *, uint32_t);
+uint8_t receber_servidor(ConexaoServidor *, void *, size_t);
+uint8_t enviar_mensagem(ConexaoServidor *, TipoMensagem, const void *, uint32_t);
+void enviar_terminal_servidor(ConexaoServidor *);
+int escrever_terminal_servidor(void *, uint32_t, uint32_t);
+ssize_t escrever_trace_servidor(void *, const char *, size_t);
+#endif
+#ifdef EXECUCAO_EM_LOTE
+int executar_lote(int, char **);
+void *executar_trabalhador_lote(void *);
+uint8_t obter_trabalho_lote(Lote *, int, uint32_t *);
+void executar_trabalho_lote(Lote *, TrabalhoLote *);
+Poxim *preparar_trabalho_lote(Lote *, TrabalhoLote *);
+void concluir_trabalho_lote(TrabalhoLote *, Poxim *);
+#endif
+#ifdef EXECUCAO_VETORIAL
+void executar_trabalhos_vetoriais(Lote *, uint32_t *, uint32_t);
+void executar_grupo_vetorial(GrupoVetorial *);
+uint32_t executar_passo_vetorial(GrupoVetorial *, uint32_t, uint32_t);
+uint32_t executar_operacao_vetorial(GrupoVetorial *, InstrucaoDecodificada *, uint32_t);
+__attribute__((target("avx2"))) __m256i flags_vetoriais(OperacaoFlags, __m256i, __m256i, __m256i, int32_t);
+__attribute__((target("avx2"))) void deslocar_vetorial(GrupoVetorial *, InstrucaoDecodificada *, __m256i);
+uint32_t acessar_memoria_vetorial(GrupoVetorial *, InstrucaoDecodificada *, uint32_t);
+uint8_t instrucao_vetorial(InstrucaoDecodificada *);
+__attribute__((target("avx2"))) __m256i desvios_tomados(Operacao, __m256i);
+void carregar_pista(GrupoVetorial *, int);
+void descarregar_pista(GrupoVetorial *, int);
+void executar_pista_escalar(GrupoVetorial *, int);
+#endif
+#ifdef CACHE_RESULTADOS
+uint8_t restaurar_resultado(Poxim *, const uint32_t *, uint32_t, const char *);
+void guardar_resultado(Poxim *);
+void descartar_resultados(Poxim *);
+int comparar_resultados(const void *, const void *);
+uint8_t copiar_arquivo(const char *, const char *);
+#endif
+#if defined(CACHE_RESULTADOS) || defined(TRADUCAO_ANTECIPADA)
+uint8_t resumir_imagem(const uint32_t *, uint32_t, const uint32_t *, uint32_t, char *);
+void calcular_identificacao_simulador();
+void iniciar_sha256(Sha256 *);
+void atualizar_sha256(Sha256 *, const void *, size_t);
+void concluir_sha256(Sha256 *, uint8_t *);
+void processar_bloco_sha256(Sha256 *, const uint8_t *);
+#endif
+Poxim *criar_maquina();
+void executar_maquina(Poxim *);
+uint8_t inicializar_simulador(Poxim *, const uint32_t *, uint32_t);
+void *reservar_memoria(size_t);
+InstrucaoDecodificada *obter_instrucao(Poxim *, uint32_t);
+InstrucaoDecodificada *buscar_instrucao(Poxim *, uint32_t);
+InstrucaoDecodificada *alocar_pagina_instrucoes(Poxim *, uint32_t);
+void descartar_paginas_instrucoes(Poxim *, uint32_t);
+uint8_t entradas_contiguas(uint32_t, uint32_t);
+void iniciar_execucao(Poxim *);
+void encerrar_execucao(Poxim *);
+void finalizar_simulador(Poxim *);
+void liberar_simulador(Poxim *);
+void retornar_instrucao_invalida(Poxim *, InstrucaoDecodificada *);
+void ativar_flag(Poxim *, Flag);
+void desativar_flag(Poxim *, Flag);
+uint8_t verificar_flag_setada(Poxim *, Flag);
+void registrar_flags(Poxim *, OperacaoFlags, uint8_t, uint8_t, uint8_t, uint8_t, int32_t);
+uint32_t operando_flags(Poxim *, uint8_t, uint32_t);
+void atribuir_flag(Poxim *, Flag, uint8_t);
+void materializar_flags(Poxim *);
+void preparar_execucao_ISR(Poxim *);
+void decodificar_instrucao(Poxim *, InstrucaoDecodificada *, uint32_t);
+void decodificar_palavra(InstrucaoDecodificada *, uint32_t, uint32_t);
+void concluir_instrucao(Poxim *);
+void agendar_evento(Poxim *, Evento, uint64_t);
+void processar_eventos(Poxim *);
+void executar_despacho_encadeado(Poxim *);
+void executar_instrucao(Poxim *, InstrucaoDecodificada *);
+#ifdef BLOCOS_BASICOS
+void executar_blocos_basicos(Poxim *);
+Bloco *obter_bloco(Poxim *, uint32_t);
+void traduzir_bloco(Poxim *, Bloco *, uint32_t);
+uint8_t encerra_bloco(Operacao);
+Bloco *encadear_bloco(Poxim *, Bloco *, uint32_t);
+#endif
+#if defined(JIT_X86_64) || defined(TRADUCAO_ANTECIPADA)
+uint8_t instrucao_compilavel(InstrucaoDecodificada *);
+uint8_t instrucao_nativa(InstrucaoDecodificada *);
+uint8_t registrador_especial(uint8_t);
+#endif
+#ifdef JIT_X86_64
+void inicializar_jit(Poxim *);
+void compilar_bloco(Poxim *, Bloco *);
+void jit_byte(Poxim *, uint8_t);
+void jit_dword(Poxim *, uint32_t);
+void jit_qword(Poxim *, uint64_t);
+void jit_registrador(Poxim *, uint8_t, uint8_t, uint8_t);
+void jit_flags(Poxim *, uint8_t, uint8_t, uint8_t);
+void jit_chamada(Poxim *, void *);
+void jit_saida(Poxim *, uint32_t, InstrucaoDecodificada *, uint32_t);
+void jit_registrar_flags(Poxim *, OperacaoFlags, uint8_t, uint8_t, uint8_t, int32_t);
+uint8_t *jit_desvio_curto(Poxim *, uint8_t);
+void jit_resolver_desvio(Poxim *, uint8_t *);
+#endif
+#ifdef PERFIL_SUPERINSTRUCOES
+void registrar_perfil(Poxim *, Operacao, uint32_t);
+void contar_sequencia(SequenciaPerfil *, uint32_t, uint64_t);
+Operacao operacao_da_sequencia(uint32_t, uint32_t);
+void gravar_perfil(Poxim *);
+const char *nome_operacao(Operacao);
+const char *nome_tratador(Operacao);
+uint8_t sequencia_elegivel(uint32_t);
+int comparar_sequencias(const void *, const void *);
+int comparar_tamanhos(const void *, const void *);
+int gerar_superinstrucoes(int, char **);
+#endif
+#ifdef TRADUCAO_ANTECIPADA
+void carregar_traducao_antecipada(Poxim *, uint32_t);
+uint8_t gerar_traducao_antecipada(Poxim *, const char *, uint32_t);
+uint8_t compilar_traducao_antecipada(const char *, const char *);
+void gerar_bloco_traduzido(FILE *, uint32_t, InstrucaoDecodificada *, uint32_t);
+void gerar_saida_traduzida(FILE *, uint32_t, InstrucaoDecodificada *, uint32_t);
+void executar_instrucao_traduzida(Poxim *, uint32_t);
+uint32_t (*obter_traducao_antecipada(Poxim *, Bloco *))(Poxim *);
+#endif
+void registrar_desempenho(Poxim *, struct timespec *);
+uint64_t resumir_palavra(uint64_t, uint32_t);
+uint64_t resumir_palavras(uint64_t, const uint32_t *, uint32_t);
+void invalidar_instrucao_decodificada(Poxim *, uint32_t);
+void imprimir_output_terminal(Poxim *);
+void imprimir_resumo_execucao(Poxim *);
+void registrar_instrucao_invalida(Poxim *, uint32_t);
+void registrar_interrupcao_software(Poxim *);
+void registrar_interrupcao_hardware(Poxim *, uint8_t);
+void adicionar_caractere_output(Poxim *, char);
+uint8_t ler_dispositivo(Poxim *, PoximDevice, uint32_t, uint32_t *);
+uint8_t escrever_dispositivo(Poxim *, PoximDevice, uint32_t, uint32_t);
+void registrar_regiao(Poxim *, uint32_t, uint32_t, uint8_t (*)(Poxim *, uint32_t, uint8_t, uint32_t *), uint8_t (*)(Poxim *, uint32_t, uint8_t, uint32_t));
+uint8_t ler_barramento(Poxim *, uint32_t, uint8_t, uint32_t *);
+uint8_t escrever_barramento(Poxim *, uint32_t, uint8_t, uint32_t);
+uint8_t ler_terminal(Poxim *, uint32_t, uint8_t, uint32_t *);
+uint8_t escrever_terminal(Poxim *, uint32_t, uint8_t, uint32_t);
+uint8_t ler_watchdog(Poxim *, uint32_t, uint8_t, uint32_t *);
+uint8_t escrever_watchdog(Poxim *, uint32_t, uint8_t, uint32_t);
+uint8_t ler_fpu(Poxim *, uint32_t, uint8_t, uint32_t *);
+uint8_t escrever_fpu(Poxim *, uint32_t, uint8_t, uint32_t);
+uint8_t ler_imagem(const char *, Imagem *);
+void liberar_imagem(Imagem *);
+uint8_t interpretar_imagem_hex(const char *, size_t, uint32_t *, uint32_t *);
+uint8_t decodificar_palavra_hexadecimal(const char *, uint32_t *);
+uint32_t *ler_imagem_hex(const char *, uint32_t *);
+int gravar_imagem_binaria(int, char **);
+#ifdef TRACE_ASSINCRONO
+void iniciar_trace_assincrono(Poxim *);
+void encerrar_trace_assincrono(Poxim *);
+void *executar_thread_trace(void *);
+#endif
+
+// Funções do trace
+void inicializar_trace(Poxim *);
+void trace_descarregar(Poxim *);
+void trace_iniciar_linha(Poxim *);
+void trace_concluir_instrucao(Poxim *);
+void trace_caractere(Poxim *, char);
+void trace_texto(Poxim *, const char *);
+void trace_hexadecimal(Poxim *, uint64_t, int);
+void trace_decimal(Poxim *, int64_t);
+void trace_registrador(Poxim *, uint8_t);
+void trace_registrador_maiusculo(Poxim *, uint8_t);
+void trace_endereco_relativo(Poxim *, uint8_t, int32_t);
+void trace_sr(Poxim *, uint32_t);
+uint8_t listar_registradores_pilha(InstrucaoDecodificada *, uint8_t *);
+void emitir_passo(Poxim *, PassoTrace *);
+void escrever_passo(Poxim *, PassoTrace *);
+void renderizar_passo(Poxim *, PassoTrace *);
+void renderizar_instrucao(Poxim *, PassoTrace *);
+Desmontagem *obter_desmontagem(Poxim *, uint32_t, uint32_t);
+void desmontar_instrucao(Poxim *, InstrucaoDecodificada *);
+void renderizar_valores(Poxim *, InstrucaoDecodificada *, PassoTrace *);
+void agendar_interrupcao(Poxim *, uint8_t, uint32_t, uint32_t);
+void tratar_interrupcao(Poxim *);
+void executar_watchdog(Poxim *);
+void decodificar_instrucao_fpu(Poxim *, uint8_t);
+void fpu_adicao(Poxim *);
+void fpu_subtracao(Poxim *);
+void fpu_multiplicacao(Poxim *);
+void fpu_divisao(Poxim *);
+void fpu_atribuicao_x(Poxim *);
+void fpu_atribuicao_y(Poxim *);
+void fpu_teto(Poxim *);
+void fpu_piso(Poxim *);
+void fpu_arredondamento(Poxim *);
+void fpu_interrupcao(Poxim *);
+void fpu_preparar_interrupcao(Poxim *, uint8_t, int);
+void executar_logica_fpu(Poxim *);
 
 // Funções de debug
-void visualizar_memoria();
-void visualizar_registradores();
-void visualizar_interrupcoes_pendentes();
+void visualizar_memoria(Poxim *);
+void visualizar_registradores(Poxim *);
+void visualizar_interrupcoes_pendentes(Poxim *);
 
 // Operações
-void _mov();
-void _movs();
-void _add();
-void _sub();
-void _mul();
-void _sll();
-void _muls();
-void _sla();
-void _div();
-void _srl();
-void _divs();
-void _sra();
-void _cmp();
-void _and();
-void _or();
-void _not();
-void _xor();
-void _push();
-void _pop();
-void _addi();
-void _subi();
-void _muli();
-void _divi();
-void _modi();
-void _cmpi();
-void _l8();
-void _l16();
-void _l32();
-void _s8();
-void _s16();
-void _s32();
-void _callf();
-void _ret();
-void _reti();
-void _cbr();
-void _sbr();
-void _bae();
-void _bat();
-void _bbe();
-void _bbt();
-void _beq();
-void _bge();
-void _bgt();
-void _biv();
-void _ble();
-void _blt();
-void _bne();
-void _bni();
-void _bnz();
-void _bun();
-void _bzd();
-void _calls();
-void _int();
-
+void _mov(Poxim *, InstrucaoDecodificada *);
+void _movs(Poxim *, InstrucaoDecodificada *);
+void _add(Poxim *, InstrucaoDecodificada *);
+void _sub(Poxim *, InstrucaoDecodificada *);
+void _mul(Poxim *, InstrucaoDecodificada *);
+void _sll(Poxim *, InstrucaoDecodificada *);
+void _muls(Poxim *, InstrucaoDecodificada *);
+void _sla(Poxim *, InstrucaoDecodificada *);
+void _div(Poxim *, InstrucaoDecodificada *);
+void _srl(Poxim *, InstrucaoDecodificada *);
+void _divs(Poxim *, InstrucaoDecodificada *);
+void _sra(Poxim *, InstrucaoDecodificada *);
+void _cmp(Poxim *, InstrucaoDecodificada *);
+void _and(Poxim *, InstrucaoDecodificada *);
+void _or(Poxim *, InstrucaoDecodificada *);
+void _not(Poxim *, InstrucaoDecodificada *);
+void _xor(Poxim *, InstrucaoDecodificada *);
+void _push(Poxim *, InstrucaoDecodificada *);
+void _pop(Poxim *, InstrucaoDecodificada *);
+void _addi(Poxim *, InstrucaoDecodificada *);
+void _subi(Poxim *, InstrucaoDecodificada *);
+void _muli(Poxim *, InstrucaoDecodificada *);
+void _divi(Poxim *, InstrucaoDecodificada *);
+void _modi(Poxim *, InstrucaoDecodificada *);
+void _cmpi(Poxim *, InstrucaoDecodificada *);
+void _cmp_desvio(Poxim *, InstrucaoDecodificada *);
+uint8_t desvio_fundivel(Operacao);
+uint8_t condicao_comparacao(InstrucaoDecodificada *, uint32_t, uint32_t, Operacao);
+void _l8(Poxim *, InstrucaoDecodificada *);
+void _l16(Poxim *, InstrucaoDecodificada *);
+void _l32(Poxim *, InstrucaoDecodificada *);
+void _s8(Poxim *, InstrucaoDecodificada *);
+void _s16(Poxim *, InstrucaoDecodificada *);
+void _s32(Poxim *, InstrucaoDecodificada *);
+void _callf(Poxim *, InstrucaoDecodificada *);
+void _ret(Poxim *, InstrucaoDecodificada *);
+void _reti(Poxim *, InstrucaoDecodificada *);
+void _cbr(Poxim *, InstrucaoDecodificada *);
+void _sbr(Poxim *, InstrucaoDecodificada *);
+void _bae(Poxim *, InstrucaoDecodificada *);
+void _bat(Poxim *, InstrucaoDecodificada *);
+void _bbe(Poxim *, InstrucaoDecodificada *);
+void _bbt(Poxim *, InstrucaoDecodificada *);
+void _beq(Poxim *, InstrucaoDecodificada *);
+void _bge(Poxim *, InstrucaoDecodificada *);
+void _bgt(Poxim *, InstrucaoDecodificada *);
+void _biv(Poxim *, InstrucaoDecodificada *);
+void _ble(Poxim *, InstrucaoDecodificada *);
+void _blt(Poxim *, InstrucaoDecodificada *);
+void _bne(Poxim *, InstrucaoDecodificada *);
+void _bni(Poxim *, InstrucaoDecodificada *);
+void _bnz(Poxim *, InstrucaoDecodificada *);
+void _bun(Poxim *, InstrucaoDecodificada *);
+void _bzd(Poxim *, InstrucaoDecodificada *);
+void _calls(Poxim *, InstrucaoDecodificada *);
+void _int(Poxim *, InstrucaoDecodificada *);
+
+// Tratadores das operações, indexados pela Operacao atribuída pelo decodificador
+void (*tratadores[TOTAL_OPERACOES])(Poxim *, InstrucaoDecodificada *) = {
+    [OP_MOV] = _mov,
+    [OP_MOVS] = _movs,
+    [OP_ADD] = _add,
+    [OP_SUB] = _sub,
+    [OP_MUL] = _mul,
+    [OP_SLL] = _sll,
+    [OP_MULS] = _muls,
+    [OP_SLA] = _sla,
+    [OP_DIV] = _div,
+    [OP_SRL] = _srl,
+    [OP_DIVS] = _divs,
+    [OP_SRA] = _sra,
+    [OP_INVALIDA] = retornar_instrucao_invalida,
+    [OP_CMP] = _cmp,
+    [OP_AND] = _and,
+    [OP_OR] = _or,
+    [OP_NOT] = _not,
+    [OP_XOR] = _xor,
+    [OP_PUSH] = _push,
+    [OP_POP] = _pop,
+    [OP_ADDI] = _addi,
+    [OP_SUBI] = _subi,
+    [OP_MULI] = _muli,
+    [OP_DIVI] = _divi,
+    [OP_MODI] = _modi,
+    [OP_CMPI] = _cmpi,
+    [OP_L8] = _l8,
+    [OP_L16] = _l16,
+    [OP_L32] = _l32,
+    [OP_S8] = _s8,
+    [OP_S16] = _s16,
+    [OP_S32] = _s32,
+    [OP_CALLF] = _callf,
+    [OP_RET] = _ret,
+    [OP_RETI] = _reti,
+    [OP_CBR] = _cbr,
+    [OP_SBR] = _sbr,
+    [OP_BAE] = _bae,
+    [OP_BAT] = _bat,
+    [OP_BBE] = _bbe,
+    [OP_BBT] = _bbt,
+    [OP_BEQ] = _beq,
+    [OP_BGE] = _bge,
+    [OP_BGT] = _bgt,
+    [OP_BIV] = _biv,
+    [OP_BLE] = _ble,
+    [OP_BLT] = _blt,
+    [OP_BNE] = _bne,
+    [OP_BNI] = _bni,
+    [OP_BNZ] = _bnz,
+    [OP_BUN] = _bun,
+    [OP_BZD] = _bzd,
+    [OP_CALLS] = _calls,
+    [OP_INT] = _int
+};
+
+#ifdef SUPERINSTRUCOES
+// Sequência de operações em endereços consecutivos executada em um único despacho
+typedef struct superinstrucao {
+    uint8_t tamanho;
+    Operacao operacoes[4];
+    void (*executar)(Poxim *, InstrucaoDecodificada *);
+} Superinstrucao;
+
+uint8_t instalar_superinstrucao(Poxim *, InstrucaoDecodificada *, uint32_t);
+uint8_t avancar_superinstrucao(Poxim *, InstrucaoDecodificada *, Operacao);
+
+// Tratadores e TABELA_SUPERINSTRUCOES, gerados com --superinstructions (compilado com -DPERFIL_SUPERINSTRUCOES)
+#include "superinstrucoes.h"
+#endif
+
+#ifndef BIBLIOTECA_POXIM
 int main(int argc, char *argv[])
 {
-    // INICIALIZANDO SIMULADOR
-
-    // Ponteiros de entrada e saida inicializados com as respectivas permissões
-    entrada = fopen(argv[1], "r");
-    saida = fopen(argv[2], "w");
-
-    // Ponteiro de debug inicializado
-    debug = fopen("debug.txt", "w");
+    // Modo renderizador: converte um trace binário no texto do trace completo, sem simular
+    if(argc > 1 && !strcmp(argv[1], "--render"))
+        return renderizar_trace_binario(argc, argv);
+
+    // Modo conversor: grava a imagem de um arquivo .hex como imagem binária, carregada sem interpretar texto
+    if(argc > 1 && !strcmp(argv[1], "--pack"))
+        return gravar_imagem_binaria(argc, argv);
+
+#ifdef SERVIDOR
+    // Modo servidor: atende pedidos de simulação em um soquete Unix, mantendo as máquinas entre eles
+    if(argc > 1 && !strcmp(argv[1], "--serve"))
+        return executar_servidor(argc, argv);
+#endif
+
+#ifdef EXECUCAO_EM_LOTE
+    // Modo lote: executa os pares (entrada, saída) de um manifesto em paralelo, um por máquina
+    if(argc > 1 && !strcmp(argv[1], "--batch"))
+        return executar_lote(argc, argv);
+#endif
+
+#ifdef PERFIL_SUPERINSTRUCOES
+    // Modo gerador: combina perfis de execução e gera as superinstruções mais vantajosas
+    if(argc > 1 && !strcmp(argv[1], "--superinstructions"))
+        return gerar_superinstrucoes(argc, argv);
+#endif
 
-    inicializar_simulador();
+    // INICIALIZANDO SIMULADOR
 
-    // Executa as instruções enquanto o programa não for interrompido
-    while(emExecucao) {
-        // Carregando a instrução de 32 bits (4 bytes) da memória indexada pelo PC (R29) no registrador IR (R28)
-        R[IR] = MEM[R[PC] >> 2];
+    Poxim *maquina = poxim_create();
+    Imagem imagem;
 
-        // Obtendo o código da operação (6 bits mais significativos)
-        uint8_t codOp = (R[IR] & (0b111111 << 26)) >> 26;
+    // Opções e imagem do arquivo de entrada
+    if(!interpretar_opcoes(maquina, argc, argv) || !ler_imagem(argv[1], &imagem)) {
+        poxim_destroy(maquina);
+        return 1;
+    }
 
-        // Definindo o pcAtual
-        pcAtual = R[PC];
+#ifdef CACHE_RESULTADOS
+    // Mesma imagem e mesmo trace de uma execução anterior: a saída é copiada da cache, sem simular
+    if(restaurar_resultado(maquina, imagem.palavras, imagem.quantidade, argv[2])) {
+        liberar_imagem(&imagem);
+        poxim_destroy(maquina);
+        return 0;
+    }
+#endif
 
-        // Decodificando a instrução buscada na memória
-        decodificar_instrucao(codOp);
+    // Arquivo de saída e carga da imagem
+    if(poxim_set_output(maquina, argv[2]) || poxim_load_image(maquina, imagem.palavras, imagem.quantidade)) {
+        liberar_imagem(&imagem);
+        poxim_destroy(maquina);
+        return 1;
+    }
 
-        // Verificando se o controle de interrupção está ligado e há interrupções pendentes
-        if(verificar_flag_setada(IE) && interrupcoesAgendadas) {
-            preparar_execucao_ISR();
-            tratar_interrupcao();
-        }
+    liberar_imagem(&imagem);
 
-        // Lógica de implementação do watchdog
-        if(watchdog & ((0b1 << 31) >> 31))
-            executar_watchdog();
+    // Ponteiro de debug inicializado
+    maquina->debug = fopen("debug.txt", "w");
 
-        // Lógica de implementação das operações do FPU
-        if(fpuControle & 0b11111 && fpuContador == -1)
-            decodificar_instrucao_fpu(fpuControle & 0b11111);
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
 
-        // Contador do FPU
-        if(fpuContador != -1)
-            executar_logica_fpu();
+    poxim_run(maquina, POXIM_SEM_LIMITE);
 
-        // PC = PC + 4 (próxima instrução)
-        R[PC] = R[PC] + 4;
-    }
+    registrar_desempenho(maquina, &inicio);
 
     // FINALIZANDO SIMULADOR
 
-    finalizar_simulador();
+    poxim_destroy(maquina);
 
     // Retornando 0
     return 0;
 }
+#endif
 
-void _mov()
+void executar_maquina(Poxim *maquina)
 {
-    uint32_t xyl = R[IR] & 0x1FFFFF;
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-
-    R[z] = xyl;
+#ifdef DESPACHO_ENCADEADO
+    // Despacho por código encadeado (compilar com -DDESPACHO_ENCADEADO)
+    executar_despacho_encadeado(maquina);
+#elif defined(BLOCOS_BASICOS)
+    // Execução por blocos básicos traduzidos e encadeados (compilar com -DBLOCOS_BASICOS)
+    executar_blocos_basicos(maquina);
+#else
+    // Executa as instruções enquanto o programa não for interrompido
+    while(maquina->emExecucao) {
+        // Obtendo a instrução pré-decodificada indexada pelo PC (R29), decodificando-a na primeira execução
+        InstrucaoDecodificada *instrucaoAtual = buscar_instrucao(maquina, maquina->R[PC]);
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+        executar_instrucao(maquina, instrucaoAtual);
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
+#ifdef PERFIL_SUPERINSTRUCOES
+        if(maquina->perfil)
+            registrar_perfil(maquina, instrucaoAtual->operacao, maquina->pcAtual);
+#endif
 
-    sprintf(instrucao, "mov %s,%u", registradorZ, R[z]);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=0x%08X\n", pcAtual, instrucao, str_upper(registradorZ), xyl);
+        concluir_instrucao(maquina);
+    }
+#endif
 }
 
-void _movs()
+void executar_instrucao(Poxim *maquina, InstrucaoDecodificada *instrucaoAtual)
 {
-    uint32_t xyl = R[IR] & 0x1FFFFF;
-    uint8_t x4 = (xyl & 0x100000) >> 20;
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
+    maquina->instrucoesExecutadas++;
 
-    if(x4)
-        R[z] = xyl | 0xFFE00000;
-    else
-        R[z] = xyl;
+    // Instruções que leem ou escrevem o SR como operando precisam das flags calculadas
+    // e, se alterarem o IE, de uma verificação das interrupções pendentes
+    if(instrucaoAtual->usaSR) {
+        materializar_flags(maquina);
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+        if(maquina->interrupcoesAgendadas)
+            agendar_evento(maquina, EVENTO_INTERRUPCOES, maquina->instrucoesExecutadas);
+    }
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
+    // Carregando a instrução de 32 bits (4 bytes) no registrador IR (R28)
+    maquina->R[IR] = instrucaoAtual->ir;
 
-    sprintf(instrucao, "movs %s,%d", registradorZ, R[z]);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=0x%08X\n", pcAtual, instrucao, str_upper(registradorZ), (int32_t)R[z]);
+    // Definindo o pcAtual
+    maquina->pcAtual = maquina->R[PC];
+
+    // Executando a instrução
+    instrucaoAtual->executar(maquina, instrucaoAtual);
 }
 
-void _add()
+void concluir_instrucao(Poxim *maquina)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-
-    R[z] = R[x] + R[y];
-
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
-
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
-
-    uint8_t rz31, rx31, ry31;
-    rz31 = ((R[z] & 0x80000000) >> 31);
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    // Interrupções, watchdog e FPU só são verificados na instrução do próximo evento agendado
+    if(maquina->instrucoesExecutadas >= maquina->proximoEvento)
+        processar_eventos(maquina);
 
-    rx31 = ((R[x] & 0x80000000) >> 31);
-    ry31 = ((R[y] & 0x80000000) >> 31);
-    if(rx31 == ry31 && rz31 != rx31)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
-
-    uint8_t rz32 = (((((uint64_t)R[x] + (uint64_t)R[y])) >> 32) & 0b1);
-    if(rz32 == 1)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
+    // PC = PC + 4 (próxima instrução)
+    maquina->R[PC] = maquina->R[PC] + 4;
+}
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+void agendar_evento(Poxim *maquina, Evento evento, uint64_t instrucao)
+{
+    maquina->eventos[evento] = instrucao;
 
-    sprintf(instrucao, "add %s,%s,%s", registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s+%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
+    if(instrucao < maquina->proximoEvento)
+        maquina->proximoEvento = instrucao;
 }
 
-void _sub()
+void processar_eventos(Poxim *maquina)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
+    uint64_t agora = maquina->instrucoesExecutadas;
 
-    R[z] = R[x] - R[y];
+    // Verificando se o controle de interrupção está ligado e há interrupções pendentes
+    if(maquina->eventos[EVENTO_INTERRUPCOES] <= agora) {
+        maquina->eventos[EVENTO_INTERRUPCOES] = EVENTO_INATIVO;
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+        if(verificar_flag_setada(maquina, IE) && maquina->interrupcoesAgendadas) {
+            preparar_execucao_ISR(maquina);
+            tratar_interrupcao(maquina);
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+            // As restantes são tratadas uma por instrução enquanto o IE continuar ligado
+            if(maquina->interrupcoesAgendadas)
+                agendar_evento(maquina, EVENTO_INTERRUPCOES, agora + 1);
+        }
+    }
 
-    uint8_t rz31, rx31, ry31;
-    rz31 = ((R[z] & 0x80000000) >> 31);
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    // Expiração do watchdog
+    if(maquina->eventos[EVENTO_WATCHDOG] <= agora) {
+        maquina->eventos[EVENTO_WATCHDOG] = EVENTO_INATIVO;
+        executar_watchdog(maquina);
+    }
 
-    rx31 = ((R[x] & 0x80000000) >> 31);
-    ry31 = ((R[y] & 0x80000000) >> 31);
-    if(rx31 != ry31 && rz31 != rx31)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    // Lógica de implementação das operações do FPU
+    if(maquina->eventos[EVENTO_FPU_INICIO] <= agora) {
+        maquina->eventos[EVENTO_FPU_INICIO] = EVENTO_INATIVO;
 
-    uint8_t rz32 = (((((uint64_t)R[x] - (uint64_t)R[y])) >> 32) & 0b1);
-    if(rz32 == 1)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
+        if(maquina->fpuControle & 0b11111 && maquina->fpuContador == -1)
+            decodificar_instrucao_fpu(maquina, maquina->fpuControle & 0b11111);
+    }
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+    // Conclusão da operação do FPU
+    if(maquina->eventos[EVENTO_FPU_CONCLUSAO] <= agora) {
+        maquina->eventos[EVENTO_FPU_CONCLUSAO] = EVENTO_INATIVO;
+        executar_logica_fpu(maquina);
+    }
+
+    // Limite de poxim_run: a execução para após esta instrução, a menos que o programa já tenha terminado
+    if(maquina->eventos[EVENTO_PAUSA] <= agora) {
+        maquina->eventos[EVENTO_PAUSA] = EVENTO_INATIVO;
+
+        if(maquina->emExecucao) {
+            maquina->emExecucao = 0;
+            maquina->pausada = 1;
+        }
+    }
 
-    sprintf(instrucao, "sub %s,%s,%s", registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s-%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
+    maquina->proximoEvento = EVENTO_INATIVO;
+    for(int evento = 0; evento < TOTAL_EVENTOS; evento++)
+        if(maquina->eventos[evento] < maquina->proximoEvento)
+            maquina->proximoEvento = maquina->eventos[evento];
 }
 
-void _mul()
+#ifdef BLOCOS_BASICOS
+void executar_blocos_basicos(Poxim *maquina)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
+    Bloco *bloco = obter_bloco(maquina, maquina->R[PC]);
 
-    R[l4_0] = (((uint64_t)R[x] * (uint64_t)R[y]) & (0xFFFFFFFF00000000)) >> 32;
-    R[z] = R[x] * R[y];
+    while(maquina->emExecucao) {
+        // PC além da tabela de blocos ou desalinhado: executado instrução por instrução, como no laço principal
+        if(!bloco) {
+            InstrucaoDecodificada *instrucaoAtual = buscar_instrucao(maquina, maquina->R[PC]);
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+            executar_instrucao(maquina, instrucaoAtual);
+            concluir_instrucao(maquina);
 
-    // Campos afetados
-    if(((((uint64_t)R[l4_0]) << 32) | R[z]) == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+            bloco = obter_bloco(maquina, maquina->R[PC]);
+            continue;
+        }
 
-    if(R[l4_0] != 0)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
-    formatar_string_registrador(l4_0, registradorL);
-
-    sprintf(instrucao, "mul %s,%s,%s,%s", registradorL, registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s:%s=%s*%s=0x%016lX,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorL),
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        ((((uint64_t)(R[l4_0])) << 32) | R[z]),
-        R[SR]
-    );
-}
-
-void _sll()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
-    uint64_t rzy = (((uint64_t)R[z]) << 32) | R[y];
-
-    R[z] = ((rzy * (potencia(2, (l4_0 + 1)))) & (0xFFFFFFFF00000000)) >> 32;
-    R[x] = (rzy * (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+#if defined(JIT_X86_64) || defined(TRADUCAO_ANTECIPADA)
+#ifdef JIT_X86_64
+        // Blocos quentes são compilados; o código nativo só é usado se nenhum evento vencer no meio do bloco
+        if(!bloco->codigoNativo && ++bloco->execucoes == LIMIAR_JIT && maquina->modoTrace != TRACE_COMPLETO)
+            compilar_bloco(maquina, bloco);
+#endif
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+        if(bloco->codigoNativo && maquina->instrucoesExecutadas + bloco->quantidade < maquina->proximoEvento) {
+            // Quantidade de instruções executadas; o código nativo deixa PC e IR como o interpretador deixaria
+            uint32_t executadas = bloco->codigoNativo(maquina);
 
-    // Campos afetados
-    if(((((uint64_t)R[z]) << 32) | R[x]) == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+            if(executadas) {
+                maquina->instrucoesExecutadas += executadas;
+                maquina->pcAtual = bloco->inicio + 4 * (executadas - 1);
 
-    if(R[z] != 0)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
-
-    sprintf(instrucao, "sll %s,%s,%s,%u", registradorZ, registradorX, registradorY, l4_0);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s:%s=%s:%s<<%u=0x%016lX,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorZ),
-        str_upper(registradorY),
-        l4_0 + 1,
-        (((uint64_t)R[z]) << 32) | R[x],
-        R[SR]
-    );
-}
-
-void _muls()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
-    int64_t rx64, ry64;
+                bloco = encadear_bloco(maquina, bloco, maquina->R[PC]);
+                continue;
+            }
+        }
+#endif
 
-    rx64 = (int64_t)(int32_t)R[x];
-    ry64 = (int64_t)(int32_t)R[y];
+        uint32_t pcSeguinte = bloco->inicio;
 
-    R[l4_0] = ((rx64 * ry64) & 0xFFFFFFFF00000000) >> 32;
-    R[z] = (rx64 * ry64) & 0xFFFFFFFF;
+        for(uint32_t i = 0; i < bloco->quantidade; i++) {
+            executar_instrucao(maquina, &bloco->instrucoes[i]);
+            concluir_instrucao(maquina);
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+            pcSeguinte += 4;
 
-    // Campos afetados
-    if(((((int64_t)R[l4_0]) << 32) | R[z]) == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+            // Desvio tomado, interrupção, escrita no PC, fim da execução ou código traduzido reescrito:
+            // o restante do bloco é abandonado
+            if(maquina->R[PC] != pcSeguinte || !maquina->emExecucao || bloco->geracao != maquina->geracaoBlocos)
+                break;
+        }
 
-    if(R[l4_0] != 0)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
-    formatar_string_registrador(l4_0, registradorL);
-
-    sprintf(instrucao, "muls %s,%s,%s,%s", registradorL, registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s:%s=%s*%s=0x%016lX,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorL),
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        ((((int64_t)(int32_t)R[l4_0]) << 32) | R[z]),
-        R[SR]
-    );
-}
-
-void _sla()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
-    int64_t rzy = (((int64_t)R[z]) << 32) | R[y];
-
-    R[z] = ((rzy * (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF00000000) >> 32;
-    R[x] = ((uint64_t)rzy * (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+        bloco = encadear_bloco(maquina, bloco, maquina->R[PC]);
+    }
+}
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+Bloco *obter_bloco(Poxim *maquina, uint32_t pc)
+{
+    if((pc >> 2) >= ENTRADAS_TABELA_BLOCOS || pc % 4)
+        return NULL;
 
-    // Campos afetados
-    if(((((int64_t)R[z]) << 32) | R[x]) == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+    Bloco *bloco = maquina->tabelaBlocos[pc >> 2];
 
-    if(R[z] != 0)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    if(bloco && bloco->geracao == maquina->geracaoBlocos)
+        return bloco;
+
+    // Cada bloco tem a capacidade máxima, para que os ponteiros de encadeamento continuem válidos ao retraduzi-lo
+    if(!bloco) {
+        bloco = (Bloco *)malloc(sizeof(Bloco) + TAMANHO_MAXIMO_BLOCO * sizeof(InstrucaoDecodificada));
+        maquina->tabelaBlocos[pc >> 2] = bloco;
+    }
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+    traduzir_bloco(maquina, bloco, pc);
 
-    sprintf(instrucao, "sla %s,%s,%s,%u", registradorZ, registradorX, registradorY, l4_0);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s:%s=%s:%s<<%u=0x%016lX,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorZ),
-        str_upper(registradorY),
-        l4_0 + 1,
-        (((int64_t)R[z]) << 32) | R[x],
-        R[SR]
-    );
+    return bloco;
 }
 
-void _div()
+void traduzir_bloco(Poxim *maquina, Bloco *bloco, uint32_t pc)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
+    InstrucaoDecodificada *decodificada;
+
+    bloco->inicio = pc;
+    bloco->geracao = maquina->geracaoBlocos;
+    bloco->quantidade = 0;
+    bloco->sucessores[0] = NULL;
+    bloco->sucessores[1] = NULL;
+#if defined(JIT_X86_64) || defined(TRADUCAO_ANTECIPADA)
+    bloco->execucoes = 0;
+    bloco->codigoNativo = NULL;
+#endif
+
+    do {
+        decodificada = &bloco->instrucoes[bloco->quantidade++];
+        decodificar_palavra(decodificada, maquina->MEM[pc >> 2], pc);
+        maquina->palavrasEmBlocos[pc >> 2] = 1;
+
+        pc += 4;
+    } while(bloco->quantidade < TAMANHO_MAXIMO_BLOCO && (pc >> 2) < ENTRADAS_TABELA_BLOCOS &&
+        !encerra_bloco(decodificada->operacao));
+
+#ifdef TRADUCAO_ANTECIPADA
+    bloco->codigoNativo = obter_traducao_antecipada(maquina, bloco);
+#endif
+}
 
-    if(R[y]) {
-        R[l4_0] = R[x] % R[y];
-        R[z] = R[x] / R[y];
-    }
+uint8_t encerra_bloco(Operacao operacao)
+{
+    // Desvios, chamadas, retornos e int alteram o PC; a instrução inválida desvia para o tratador
+    return operacao == OP_INVALIDA || (operacao >= OP_CALLF && operacao != OP_CBR && operacao != OP_SBR);
+}
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+Bloco *encadear_bloco(Poxim *maquina, Bloco *bloco, uint32_t pc)
+{
+    uint8_t indiceSucessor = pc != bloco->inicio + 4 * bloco->quantidade;
+    Bloco *sucessor = bloco->sucessores[indiceSucessor];
 
-    // Campos afetados
-    if(R[z] == 0 && R[y])
-        ativar_flag(ZN);
-    else if(R[y])
-        desativar_flag(ZN);
-
-    if(R[y] == 0) {
-        ativar_flag(ZD);
-
-        if(verificar_flag_setada(IE)) {
-            preparar_execucao_ISR();
-            R[CR] = 0;
-            R[IPC] = R[PC];
-            R[PC] = 0x00000008;
-            R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
-        }
-    } else {
-        desativar_flag(ZD);
-    }
-
-    if(R[l4_0] != 0)
-        ativar_flag(CY);
-    else if(R[y])
-        desativar_flag(CY);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
-    formatar_string_registrador(l4_0, registradorL);
-
-    sprintf(instrucao, "div %s,%s,%s,%s", registradorL, registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s%%%s=0x%08X,%s=%s/%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorL),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[l4_0],
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
-
-    if(verificar_flag_setada(ZD) && verificar_flag_setada(IE))
-        fprintf(saida, "[SOFTWARE INTERRUPTION]\n");
-}
-
-void _srl()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
-    uint64_t rzy = (((uint64_t)R[z]) << 32) | R[y];
-
-    R[z] = ((rzy / (potencia(2, (l4_0 + 1)))) & (0xFFFFFFFF00000000)) >> 32;
-    R[x] = (rzy / (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+    if(sucessor && sucessor->inicio == pc && sucessor->geracao == maquina->geracaoBlocos)
+        return sucessor;
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+    sucessor = obter_bloco(maquina, pc);
 
-    // Campos afetados
-    if(((((uint64_t)R[z]) << 32) | R[x]) == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+    if(bloco->geracao == maquina->geracaoBlocos)
+        bloco->sucessores[indiceSucessor] = sucessor;
 
-    if(R[z] != 0)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
+    return sucessor;
+}
+#endif
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+#if defined(JIT_X86_64) || defined(TRADUCAO_ANTECIPADA)
+uint8_t instrucao_compilavel(InstrucaoDecodificada *decodificada)
+{
+    // Instruções com o SR como operando podem agendar interrupções, que exigem a contagem exata de instruções
+    if(decodificada->usaSR)
+        return 0;
+
+    switch(decodificada->operacao) {
+        case OP_INVALIDA:
+        case OP_INT:
+            // Encerram a execução ou contam interrupções pela instrução atual
+            return 0;
+
+        case OP_S8:
+        case OP_S32:
+            // Só a escrita nativa (sem dispositivos, que agendam eventos) é usada; com PC ou IR como operando,
+            // o bloco é interpretado
+            return !registrador_especial(decodificada->z) && !registrador_especial(decodificada->x);
 
-    sprintf(instrucao, "srl %s,%s,%s,%u", registradorZ, registradorX, registradorY, l4_0);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s:%s=%s:%s>>%u=0x%016lX,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorZ),
-        str_upper(registradorY),
-        l4_0 + 1,
-        (((uint64_t)R[z]) << 32) | R[x],
-        R[SR]
-    );
+        default:
+            return 1;
+    }
 }
 
-void _divs()
+uint8_t instrucao_nativa(InstrucaoDecodificada *decodificada)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
+    // Com PC ou IR como operando, a instrução é executada pelo tratador
+    if(registrador_especial(decodificada->z) || registrador_especial(decodificada->x) || registrador_especial(decodificada->y))
+        return 0;
+
+    switch(decodificada->operacao) {
+        case OP_MOV:
+        case OP_MOVS:
+        case OP_ADD:
+        case OP_SUB:
+        case OP_AND:
+        case OP_OR:
+        case OP_XOR:
+        case OP_NOT:
+        case OP_ADDI:
+        case OP_SUBI:
+        case OP_CMP:
+        case OP_CMPI:
+        case OP_L8:
+        case OP_L32:
+        case OP_S8:
+        case OP_S32:
+        case OP_BUN:
+            return 1;
 
-    if(R[y]) {
-        R[l4_0] = (int32_t)R[x] % (int32_t)R[y];
-        R[z] = (int32_t)R[x] / (int32_t)R[y];
+        default:
+            return 0;
     }
+}
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
-
-    // Campos afetados
-    if(R[z] == 0 && R[y])
-        ativar_flag(ZN);
-    else if(R[y])
-        desativar_flag(ZN);
-
-    if(R[y] == 0) {
-        ativar_flag(ZD);
-
-        if(verificar_flag_setada(IE)) {
-            preparar_execucao_ISR();
-            R[CR] = 0;
-            R[IPC] = R[PC];
-            R[PC] = 0x00000008;
-            R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
-        }
-    } else {
-        desativar_flag(ZD);
-    }
-
-    if(R[l4_0] != 0)
-        ativar_flag(OV);
-    else if(R[y])
-        desativar_flag(OV);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
-    formatar_string_registrador(l4_0, registradorL);
-
-    sprintf(instrucao, "divs %s,%s,%s,%s", registradorL, registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s%%%s=0x%08X,%s=%s/%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorL),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[l4_0],
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
-
-    if(verificar_flag_setada(ZD) && verificar_flag_setada(IE))
-        fprintf(saida, "[SOFTWARE INTERRUPTION]\n");
-}
-
-void _sra()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t l4_0 = R[IR] & 0b11111;
-    int64_t rzy = (((int64_t)R[z]) << 32) | R[y];
-
-    R[z] = ((rzy / (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF00000000) >> 32;
-    R[x] = ((uint64_t)rzy / (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+uint8_t registrador_especial(uint8_t indice)
+{
+    // PC e IR só têm o valor esperado pelas instruções quando o tratador é chamado
+    return indice == PC || indice == IR;
+}
+#endif
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+#ifdef JIT_X86_64
+// Compilação dos blocos quentes para x86-64. No código gerado, rbx aponta para R, r12 para as flags pendentes,
+// r13 para a memória, r14 para palavrasEmBlocos e r15 para a cache de instruções. O bloco compilado devolve
+// em eax a quantidade de instruções executadas e deixa o PC na próxima instrução, como concluir_instrucao.
+// Os endereços são os da máquina dona da área executável, embutidos no código (o argumento recebido é ignorado).
+// O SR continua calculado sob demanda a partir de flagsPendentes, e não a partir das flags do processador
 
-    // Campos afetados
-    if(((((int64_t)R[z]) << 32) | R[x]) == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+void inicializar_jit(Poxim *maquina)
+{
+    void *area = mmap(NULL, CAPACIDADE_CODIGO_JIT, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 
-    if(R[z] != 0)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    // Sem a área executável, todos os blocos são interpretados
+    if(area == MAP_FAILED)
+        return;
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+    maquina->codigoJit = (uint8_t *)area;
+    maquina->cursorJit = maquina->codigoJit;
 
-    sprintf(instrucao, "sra %s,%s,%s,%u", registradorZ, registradorX, registradorY, l4_0);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s:%s=%s:%s>>%u=0x%016lX,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorZ),
-        str_upper(registradorY),
-        l4_0 + 1,
-        (((int64_t)R[z]) << 32) | R[x],
-        R[SR]
-    );
+    // Epílogo: pop r15, pop r14, pop r13, pop r12, pop rbx, ret
+    maquina->epilogoJit = maquina->cursorJit;
+    for(uint8_t r = 7; r >= 4; r--) {
+        jit_byte(maquina, 0x41);
+        jit_byte(maquina, 0x58 + r);
+    }
+    jit_byte(maquina, 0x5B);
+    jit_byte(maquina, 0xC3);
 }
 
-void _cmp()
+void compilar_bloco(Poxim *maquina, Bloco *bloco)
 {
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-
-    uint64_t cmp = (uint64_t)R[x] - (uint64_t)R[y];
-
-    // Campos afetados
-    if(cmp == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
-
-    uint8_t cmp31 = (cmp & 0x80000000) >> 31;
-    if(cmp31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    // Área executável indisponível ou cheia: o bloco continua interpretado
+    if(!maquina->codigoJit || maquina->cursorJit + RESERVA_BLOCO_JIT > maquina->codigoJit + CAPACIDADE_CODIGO_JIT)
+        return;
 
-    uint8_t rx31 = (R[x] & (0b1 << 31)) >> 31;
-    uint8_t ry31 = (R[y] & (0b1 << 31)) >> 31;
-    if(rx31 != ry31 && cmp31 != rx31)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    for(uint32_t i = 0; i < bloco->quantidade; i++)
+        if(!instrucao_compilavel(&bloco->instrucoes[i]))
+            return;
 
-    uint8_t cmp32 = ((cmp >> 32) & 0b1);
-    if(cmp32 == 1)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
+    uint8_t *inicio = maquina->cursorJit;
 
-    // Formatação da saída
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+    // Prólogo: push rbx, push r12, push r13, push r14, push r15 (a pilha fica alinhada em 16 bytes para as chamadas)
+    jit_byte(maquina, 0x53);
+    for(uint8_t r = 4; r <= 7; r++) {
+        jit_byte(maquina, 0x41);
+        jit_byte(maquina, 0x50 + r);
+    }
 
-    sprintf(instrucao, "cmp %s,%s", registradorX, registradorY);
-    fprintf(saida, "0x%08X:\t%-25s\tSR=0x%08X\n", pcAtual, instrucao, R[SR]);
-}
+    // mov rbx, R / mov r12, &flagsPendentes / mov r13, MEM / mov r14, palavrasEmBlocos / mov r15, cacheInstrucoes
+    jit_byte(maquina, 0x48);
+    jit_byte(maquina, 0xBB);
+    jit_qword(maquina, (uintptr_t)maquina->R);
 
-void _and()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
+    uintptr_t bases[4] = {(uintptr_t)&maquina->flagsPendentes, (uintptr_t)maquina->MEM, (uintptr_t)maquina->palavrasEmBlocos, (uintptr_t)maquina->cacheInstrucoes};
+    for(uint8_t r = 4; r <= 7; r++) {
+        jit_byte(maquina, 0x49);
+        jit_byte(maquina, 0xB8 + r);
+        jit_qword(maquina, bases[r - 4]);
+    }
 
-    R[z] = R[x] & R[y];
+    uint32_t pc = bloco->inicio;
+
+    for(uint32_t i = 0; i < bloco->quantidade; i++, pc += 4) {
+        InstrucaoDecodificada *decodificada = &bloco->instrucoes[i];
+        uint8_t z = decodificada->z, x = decodificada->x, y = decodificada->y;
+        InstrucaoDecodificada *anterior = i ? &bloco->instrucoes[i - 1] : NULL;
+        uint8_t *desvio;
+
+        switch(instrucao_nativa(decodificada) ? decodificada->operacao : OP_INVALIDA) {
+            case OP_MOV:
+            case OP_MOVS:
+                // mov dword [R + 4z], imediato
+                if(z) {
+                    jit_registrador(maquina, 0xC7, 0, z);
+                    jit_dword(maquina, decodificada->imediato);
+                }
+                continue;
+
+            case OP_ADD:
+            case OP_SUB:
+            case OP_AND:
+            case OP_OR:
+            case OP_XOR: {
+                // mov eax, [R + 4x]; op eax, [R + 4y]; mov [R + 4z], eax
+                const uint8_t OPCODES[TOTAL_OPERACOES] = {
+                    [OP_ADD] = 0x03, [OP_SUB] = 0x2B, [OP_AND] = 0x23, [OP_OR] = 0x0B, [OP_XOR] = 0x33
+                };
+
+                jit_registrador(maquina, 0x8B, 0, x);
+                jit_registrador(maquina, OPCODES[decodificada->operacao], 0, y);
+                if(z)
+                    jit_registrador(maquina, 0x89, 0, z);
+
+                if(decodificada->operacao == OP_ADD)
+                    jit_registrar_flags(maquina, FLAGS_ADD, z, x, y, 0);
+                else if(decodificada->operacao == OP_SUB)
+                    jit_registrar_flags(maquina, FLAGS_SUB, z, x, y, 0);
+                else
+                    jit_registrar_flags(maquina, FLAGS_LOGICA, z, 0, 0, 0);
+                continue;
+            }
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+            case OP_NOT:
+                // mov eax, [R + 4x]; not eax; mov [R + 4z], eax
+                jit_registrador(maquina, 0x8B, 0, x);
+                jit_byte(maquina, 0xF7);
+                jit_byte(maquina, 0xD0);
+                if(z)
+                    jit_registrador(maquina, 0x89, 0, z);
+
+                jit_registrar_flags(maquina, FLAGS_LOGICA, z, 0, 0, 0);
+                continue;
+
+            case OP_ADDI:
+            case OP_SUBI:
+                // mov eax, [R + 4x]; add/sub eax, imediato; mov [R + 4z], eax
+                jit_registrador(maquina, 0x8B, 0, x);
+                jit_byte(maquina, decodificada->operacao == OP_ADDI ? 0x05 : 0x2D);
+                jit_dword(maquina, decodificada->imediato);
+                if(z)
+                    jit_registrador(maquina, 0x89, 0, z);
+
+                jit_registrar_flags(maquina, decodificada->operacao == OP_ADDI ? FLAGS_ADDI : FLAGS_SUBI, z, x, 0, decodificada->imediato);
+                continue;
+
+            case OP_CMP:
+                jit_registrar_flags(maquina, FLAGS_CMP, 0, x, y, 0);
+                continue;
+
+            case OP_CMPI:
+                jit_registrar_flags(maquina, FLAGS_CMPI, 0, x, 0, decodificada->imediato);
+                continue;
+
+            case OP_L32:
+            case OP_S32:
+                // mov eax, [R + 4x]; add eax, i (índice da palavra); cmp eax, palavras da tabela de blocos
+                jit_registrador(maquina, 0x8B, 0, x);
+                jit_byte(maquina, 0x05);
+                jit_dword(maquina, (int16_t)decodificada->imediato);
+                jit_byte(maquina, 0x3D);
+                jit_dword(maquina, ENTRADAS_TABELA_BLOCOS);
+
+                if(decodificada->operacao == OP_L32) {
+                    // Dispositivos e endereços além da tabela de blocos saem para o interpretador antes da instrução
+                    desvio = jit_desvio_curto(maquina, 0x72);
+                    jit_saida(maquina, pc, anterior, i);
+                    jit_resolver_desvio(maquina, desvio);
+
+                    // mov eax, [r13 + 4rax]; mov [R + 4z], eax
+                    jit_byte(maquina, 0x41);
+                    jit_byte(maquina, 0x8B);
+                    jit_byte(maquina, 0x44);
+                    jit_byte(maquina, 0x85);
+                    jit_byte(maquina, 0x00);
+                    if(z)
+                        jit_registrador(maquina, 0x89, 0, z);
+                    continue;
+                }
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+                // Escritas em código traduzido também saem, para que o interpretador descarte os blocos:
+                // jae saída; cmp byte [r14 + rax], 0; je escrita
+                jit_byte(maquina, 0x73);
+                jit_byte(maquina, 0x07);
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0x80);
+                jit_byte(maquina, 0x3C);
+                jit_byte(maquina, 0x06);
+                jit_byte(maquina, 0x00);
+                desvio = jit_desvio_curto(maquina, 0x74);
+                jit_saida(maquina, pc, anterior, i);
+                jit_resolver_desvio(maquina, desvio);
+
+                // mov ecx, [R + 4z]; mov [r13 + 4rax], ecx
+                jit_registrador(maquina, 0x8B, 1, z);
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0x89);
+                jit_byte(maquina, 0x4C);
+                jit_byte(maquina, 0x85);
+                jit_byte(maquina, 0x00);
+
+                // imul rdx, rax, sizeof(InstrucaoDecodificada); mov byte [r15 + rdx + valida], 0
+                jit_byte(maquina, 0x48);
+                jit_byte(maquina, 0x69);
+                jit_byte(maquina, 0xD0);
+                jit_dword(maquina, sizeof(InstrucaoDecodificada));
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0xC6);
+                jit_byte(maquina, 0x84);
+                jit_byte(maquina, 0x17);
+                jit_dword(maquina, offsetof(InstrucaoDecodificada, valida));
+                jit_byte(maquina, 0x00);
+                continue;
+
+            case OP_L8:
+                // mov eax, [R + 4x]; add eax, i (endereço do byte); cmp eax, bytes da tabela de blocos
+                jit_registrador(maquina, 0x8B, 0, x);
+                jit_byte(maquina, 0x05);
+                jit_dword(maquina, (int16_t)decodificada->imediato);
+                jit_byte(maquina, 0x3D);
+                jit_dword(maquina, ENTRADAS_TABELA_BLOCOS * 4);
+
+                // Dispositivos e endereços além da tabela de blocos saem para o interpretador antes da instrução
+                desvio = jit_desvio_curto(maquina, 0x72);
+                jit_saida(maquina, pc, anterior, i);
+                jit_resolver_desvio(maquina, desvio);
+
+                // xor eax, TROCA_BYTE; movzx eax, byte [r13 + rax]; mov [R + 4z], eax
+                jit_byte(maquina, 0x83);
+                jit_byte(maquina, 0xF0);
+                jit_byte(maquina, TROCA_BYTE);
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0x0F);
+                jit_byte(maquina, 0xB6);
+                jit_byte(maquina, 0x44);
+                jit_byte(maquina, 0x05);
+                jit_byte(maquina, 0x00);
+                if(z)
+                    jit_registrador(maquina, 0x89, 0, z);
+                continue;
+
+            case OP_S8:
+                // mov eax, [R + 4x]; add eax, i; mov edx, eax; shr edx, 2 (índice da palavra); cmp eax, bytes da tabela
+                jit_registrador(maquina, 0x8B, 0, x);
+                jit_byte(maquina, 0x05);
+                jit_dword(maquina, (int16_t)decodificada->imediato);
+                jit_byte(maquina, 0x89);
+                jit_byte(maquina, 0xC2);
+                jit_byte(maquina, 0xC1);
+                jit_byte(maquina, 0xEA);
+                jit_byte(maquina, 0x02);
+                jit_byte(maquina, 0x3D);
+                jit_dword(maquina, ENTRADAS_TABELA_BLOCOS * 4);
+
+                // Como em s32: jae saída; cmp byte [r14 + rdx], 0; je escrita
+                jit_byte(maquina, 0x73);
+                jit_byte(maquina, 0x07);
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0x80);
+                jit_byte(maquina, 0x3C);
+                jit_byte(maquina, 0x16);
+                jit_byte(maquina, 0x00);
+                desvio = jit_desvio_curto(maquina, 0x74);
+                jit_saida(maquina, pc, anterior, i);
+                jit_resolver_desvio(maquina, desvio);
+
+                // mov ecx, [R + 4z]; xor eax, TROCA_BYTE; mov [r13 + rax], cl
+                jit_registrador(maquina, 0x8B, 1, z);
+                jit_byte(maquina, 0x83);
+                jit_byte(maquina, 0xF0);
+                jit_byte(maquina, TROCA_BYTE);
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0x88);
+                jit_byte(maquina, 0x4C);
+                jit_byte(maquina, 0x05);
+                jit_byte(maquina, 0x00);
+
+                // imul rdx, rdx, sizeof(InstrucaoDecodificada); mov byte [r15 + rdx + valida], 0
+                jit_byte(maquina, 0x48);
+                jit_byte(maquina, 0x69);
+                jit_byte(maquina, 0xD2);
+                jit_dword(maquina, sizeof(InstrucaoDecodificada));
+                jit_byte(maquina, 0x41);
+                jit_byte(maquina, 0xC6);
+                jit_byte(maquina, 0x84);
+                jit_byte(maquina, 0x17);
+                jit_dword(maquina, offsetof(InstrucaoDecodificada, valida));
+                jit_byte(maquina, 0x00);
+                continue;
+
+            case OP_BUN:
+                jit_saida(maquina, decodificada->alvo, decodificada, i + 1);
+                continue;
+
+            default:
+                break;
+        }
 
-    uint8_t rz31 = (R[z] & (0b1 << 31)) >> 31;
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+        // Demais instruções: chamada ao tratador do interpretador, com PC e IR como ele os encontraria
+        jit_registrador(maquina, 0xC7, 0, PC);
+        jit_dword(maquina, pc);
+        jit_registrador(maquina, 0xC7, 0, IR);
+        jit_dword(maquina, decodificada->ir);
+
+        // mov rsi, decodificada; chamada ao tratador
+        jit_byte(maquina, 0x48);
+        jit_byte(maquina, 0xBE);
+        jit_qword(maquina, (uintptr_t)decodificada);
+        jit_chamada(maquina, decodificada->executar);
+
+        // Desvio tomado ou código traduzido reescrito: cmp dword [R + 4PC], pc; jne saída;
+        // mov rax, &geracaoBlocos; cmp dword [rax], geração; je próxima
+        jit_registrador(maquina, 0x81, 7, PC);
+        jit_dword(maquina, pc);
+        uint8_t *desvioSaida = jit_desvio_curto(maquina, 0x75);
+        jit_byte(maquina, 0x48);
+        jit_byte(maquina, 0xB8);
+        jit_qword(maquina, (uintptr_t)&maquina->geracaoBlocos);
+        jit_byte(maquina, 0x81);
+        jit_byte(maquina, 0x38);
+        jit_dword(maquina, bloco->geracao);
+        desvio = jit_desvio_curto(maquina, 0x74);
+        jit_resolver_desvio(maquina, desvioSaida);
+
+        // Saída como em concluir_instrucao (o IR já foi gravado antes do tratador): add dword [R + 4PC], 4
+        jit_registrador(maquina, 0x83, 0, PC);
+        jit_byte(maquina, 4);
+        jit_byte(maquina, 0xB8);
+        jit_dword(maquina, i + 1);
+        jit_byte(maquina, 0xE9);
+        jit_dword(maquina, maquina->epilogoJit - (maquina->cursorJit + 4));
+        jit_resolver_desvio(maquina, desvio);
+    }
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+    // Fim do bloco sem desvio tomado
+    jit_saida(maquina, pc, &bloco->instrucoes[bloco->quantidade - 1], bloco->quantidade);
 
-    sprintf(instrucao, "and %s,%s,%s", registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s&%s=0x%08X,SR=0x%08X\n",
-        pcAtual, instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
+    bloco->codigoNativo = (uint32_t (*)(Poxim *))inicio;
 }
 
-void _or()
+void jit_byte(Poxim *maquina, uint8_t valor)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-
-    R[z] = R[x] | R[y];
-
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
-
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
-
-    uint8_t rz31 = (R[z] & (0b1 << 31)) >> 31;
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    *maquina->cursorJit++ = valor;
+}
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
+void jit_dword(Poxim *maquina, uint32_t valor)
+{
+    memcpy(maquina->cursorJit, &valor, sizeof(uint32_t));
+    maquina->cursorJit += sizeof(uint32_t);
+}
 
-    sprintf(instrucao, "or %s,%s,%s", registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s|%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
+void jit_qword(Poxim *maquina, uint64_t valor)
+{
+    memcpy(maquina->cursorJit, &valor, sizeof(uint64_t));
+    maquina->cursorJit += sizeof(uint64_t);
 }
 
-void _not()
+void jit_registrador(Poxim *maquina, uint8_t opcode, uint8_t campo, uint8_t indice)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
+    // opcode [rbx + 4 * indice] (deslocamento de 8 bits)
+    jit_byte(maquina, opcode);
+    jit_byte(maquina, 0x43 | (campo << 3));
+    jit_byte(maquina, indice * 4);
+}
 
-    R[z] = ~R[x];
+void jit_flags(Poxim *maquina, uint8_t opcode, uint8_t campo, uint8_t deslocamento)
+{
+    // opcode [r12 + deslocamento]
+    jit_byte(maquina, 0x41);
+    jit_byte(maquina, opcode);
+    jit_byte(maquina, 0x44 | (campo << 3));
+    jit_byte(maquina, 0x24);
+    jit_byte(maquina, deslocamento);
+}
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+void jit_chamada(Poxim *maquina, void *funcao)
+{
+    // Todas as funções chamadas recebem a máquina como primeiro argumento: mov rdi, maquina; mov rax, funcao; call rax
+    jit_byte(maquina, 0x48);
+    jit_byte(maquina, 0xBF);
+    jit_qword(maquina, (uintptr_t)maquina);
+    jit_byte(maquina, 0x48);
+    jit_byte(maquina, 0xB8);
+    jit_qword(maquina, (uintptr_t)funcao);
+    jit_byte(maquina, 0xFF);
+    jit_byte(maquina, 0xD0);
+}
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+void jit_saida(Poxim *maquina, uint32_t pc, InstrucaoDecodificada *ultima, uint32_t executadas)
+{
+    // mov dword [R + 4PC], pc; mov dword [R + 4IR], ir; mov eax, executadas; jmp epílogo
+    jit_registrador(maquina, 0xC7, 0, PC);
+    jit_dword(maquina, pc);
+
+    // Depois de um tratador, o IR fica como ele o deixou (pode ser o destino da instrução)
+    if(ultima && instrucao_nativa(ultima)) {
+        jit_registrador(maquina, 0xC7, 0, IR);
+        jit_dword(maquina, ultima->ir);
+    }
 
-    uint8_t rz31 = (R[z] & (0b1 << 31)) >> 31;
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    jit_byte(maquina, 0xB8);
+    jit_dword(maquina, executadas);
+    jit_byte(maquina, 0xE9);
+    jit_dword(maquina, maquina->epilogoJit - (maquina->cursorJit + 4));
+}
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+void jit_registrar_flags(Poxim *maquina, OperacaoFlags operacao, uint8_t z, uint8_t x, uint8_t y, int32_t imediato)
+{
+    // Operações anteriores cujas flags a nova operação sobrescreve por completo não precisam ser materializadas
+    uint32_t cobertas = 0;
+    for(int anterior = FLAGS_MATERIALIZADAS; anterior <= FLAGS_DESLOCAMENTO_ARITMETICO; anterior++)
+        if(!(FLAGS_AFETADAS[anterior] & ~FLAGS_AFETADAS[operacao]))
+            cobertas |= 0b1 << anterior;
+
+    // mov eax, [operacao]; mov ecx, cobertas; bt ecx, eax; jc registro; chamada a materializar_flags
+    jit_flags(maquina, 0x8B, 0, offsetof(FlagsPendentes, operacao));
+    jit_byte(maquina, 0xB9);
+    jit_dword(maquina, cobertas);
+    jit_byte(maquina, 0x0F);
+    jit_byte(maquina, 0xA3);
+    jit_byte(maquina, 0xC1);
+    uint8_t *desvio = jit_desvio_curto(maquina, 0x72);
+    jit_chamada(maquina, materializar_flags);
+    jit_resolver_desvio(maquina, desvio);
+
+    // Mesmo registro de registrar_flags: operação, índices e valores dos operandos após a execução
+    jit_flags(maquina, 0xC7, 0, offsetof(FlagsPendentes, operacao));
+    jit_dword(maquina, operacao);
+
+    uint8_t indices[4] = {z, x, y, 0};
+    const uint8_t CAMPOS[4] = {
+        offsetof(FlagsPendentes, z), offsetof(FlagsPendentes, x), offsetof(FlagsPendentes, y), offsetof(FlagsPendentes, l)
+    };
+    const uint8_t VALORES[4] = {
+        offsetof(FlagsPendentes, rz), offsetof(FlagsPendentes, rx), offsetof(FlagsPendentes, ry), offsetof(FlagsPendentes, rl)
+    };
+
+    for(int i = 0; i < 4; i++) {
+        // mov byte [campo], índice; mov eax, [R + 4 * índice]; mov [valor], eax
+        jit_flags(maquina, 0xC6, 0, CAMPOS[i]);
+        jit_byte(maquina, indices[i]);
+        jit_registrador(maquina, 0x8B, 0, indices[i]);
+        jit_flags(maquina, 0x89, 0, VALORES[i]);
+    }
 
-    sprintf(instrucao, "not %s,%s", registradorZ, registradorX);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=~%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        R[z],
-        R[SR]
-    );
+    jit_flags(maquina, 0xC7, 0, offsetof(FlagsPendentes, imediato));
+    jit_dword(maquina, imediato);
 }
 
-void _xor()
+uint8_t *jit_desvio_curto(Poxim *maquina, uint8_t opcode)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
+    // Desvio condicional de 8 bits para a frente, resolvido quando o destino for emitido
+    jit_byte(maquina, opcode);
+    jit_byte(maquina, 0);
 
-    R[z] = R[x] ^ R[y];
+    return maquina->cursorJit - 1;
+}
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+void jit_resolver_desvio(Poxim *maquina, uint8_t *deslocamento)
+{
+    *deslocamento = maquina->cursorJit - (deslocamento + 1);
+}
+#endif
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+#ifdef TRADUCAO_ANTECIPADA
+// Tradução antecipada: a imagem carregada é traduzida para C (uma função por bloco básico alcançável a partir
+// dos vetores de interrupção e dos destinos dos desvios diretos), compilada pelo gcc como biblioteca compartilhada
+// e carregada com dlopen. As funções seguem o mesmo contrato dos blocos compilados pelo JIT; destinos indiretos
+// (call [rx + i], ret e reti) e código reescrito voltam para o interpretador
 
-    uint8_t rz31 = (R[z] & (0b1 << 31)) >> 31;
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-    formatar_string_registrador(y, registradorY);
-
-    sprintf(instrucao, "xor %s,%s,%s", registradorZ, registradorX, registradorY);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s^%s=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        str_upper(registradorY),
-        R[z],
-        R[SR]
-    );
-}
-
-void _push()
-{
-    uint8_t v = (R[IR] & (0b11111 << 6)) >> 6;
-    uint8_t w = R[IR] & 0b11111;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
+void carregar_traducao_antecipada(Poxim *maquina, uint32_t palavras)
+{
+    char caminhoFonte[4096], caminhoBiblioteca[4096], temporarioFonte[4096], temporarioBiblioteca[4096];
 
-    uint8_t registradoresValidos = 0;
-    char stringResultadoPt1[80] = {0};
-    char stringResultadoPt2[30] = {0};
-    char stringResultado[110] = {0};
+    // No trace completo, todas as instruções são interpretadas para serem registradas
+    if(!maquina->diretorioTraducao || maquina->modoTrace == TRACE_COMPLETO)
+        return;
 
-    sprintf(instrucao, "push ");
-    sprintf(stringResultadoPt1, "MEM[0x%08X]{", R[SP]);
-    sprintf(stringResultadoPt2, "}={");
+    // Nome da biblioteca: o SHA-256 da compilação do simulador (que gerou o código), do tamanho e das palavras da
+    // imagem, como na cache de resultados. Uma biblioteca encontrada é a desta imagem e deste gerador
+    char resumo[65];
 
-    if(empilhar(v)) {
-        registradoresValidos++;
-        formatar_string_registrador(v, registradorV);
-        formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorV);
-        formatar_string_empilhamento_resultado_pt1(stringResultadoPt1, registradoresValidos, R[v]);
-        formatar_string_empilhamento_resultado_pt2(stringResultadoPt2, registradoresValidos, registradorV);
-
-        if(empilhar(w)) {
-            registradoresValidos++;
-            formatar_string_registrador(w, registradorW);
-            formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorW);
-            formatar_string_empilhamento_resultado_pt1(stringResultadoPt1, registradoresValidos, R[w]);
-            formatar_string_empilhamento_resultado_pt2(stringResultadoPt2, registradoresValidos, registradorW);
-
-            if(empilhar(x)) {
-                registradoresValidos++;
-                formatar_string_registrador(x, registradorX);
-                formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorX);
-                formatar_string_empilhamento_resultado_pt1(stringResultadoPt1, registradoresValidos, R[x]);
-                formatar_string_empilhamento_resultado_pt2(stringResultadoPt2, registradoresValidos, registradorX);
-
-                if(empilhar(y)) {
-                    registradoresValidos++;
-                    formatar_string_registrador(y, registradorY);
-                    formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorY);
-                    formatar_string_empilhamento_resultado_pt1(stringResultadoPt1, registradoresValidos, R[y]);
-                    formatar_string_empilhamento_resultado_pt2(stringResultadoPt2, registradoresValidos, registradorY);
-
-                    if(empilhar(z)) {
-                        registradoresValidos++;
-                        formatar_string_registrador(z, registradorZ);
-                        formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorZ);
-                        formatar_string_empilhamento_resultado_pt1(stringResultadoPt1, registradoresValidos, R[z]);
-                        formatar_string_empilhamento_resultado_pt2(stringResultadoPt2, registradoresValidos, registradorZ);
-                    }
-                }
-            }
-        }
-    }
+    if(!resumir_imagem(&palavras, 1, maquina->MEM, palavras, resumo))
+        return;
 
-    if(registradoresValidos == 0)
-        formatar_string_empilhamento_instrucao(instrucao, 0, NULL);
+    // Cópia da imagem, usada para verificar se o código traduzido ainda corresponde à memória
+    maquina->imagemCarregada = (uint32_t *)malloc(ENTRADAS_TABELA_BLOCOS * sizeof(uint32_t));
+    memcpy(maquina->imagemCarregada, maquina->MEM, ENTRADAS_TABELA_BLOCOS * sizeof(uint32_t));
 
-    sprintf(stringResultado, "%s%s}", stringResultadoPt1, stringResultadoPt2);
-    fprintf(saida, "0x%08X:\t%-25s\t%s\n", pcAtual, instrucao, stringResultado);
-}
+    snprintf(caminhoFonte, sizeof(caminhoFonte), "%s/poxim-%s.c", maquina->diretorioTraducao, resumo);
+    snprintf(caminhoBiblioteca, sizeof(caminhoBiblioteca), "%s/poxim-%s.so", maquina->diretorioTraducao, resumo);
 
-void _pop()
-{
-    uint8_t v = (R[IR] & (0b11111 << 6)) >> 6;
-    uint8_t w = R[IR] & 0b11111;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    uint8_t y = (R[IR] & (0b11111 << 11)) >> 11;
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
+    // A biblioteca de uma execução anterior da mesma imagem é reaproveitada
+    maquina->bibliotecaTraducao = dlopen(caminhoBiblioteca, RTLD_NOW | RTLD_LOCAL);
 
-    uint8_t registradoresValidos = 0;
-    char stringResultadoPt1[30] = {0};
-    char stringResultadoPt2[80] = {0};
-    char stringResultado[110] = {0};
+    if(!maquina->bibliotecaTraducao) {
+        // Gerada em arquivos próprios desta máquina e renomeada ao fim, já que outras máquinas
+        // (deste ou de outro processo) podem estar gerando a mesma imagem ao mesmo tempo
+        snprintf(temporarioFonte, sizeof(temporarioFonte), "%s/poxim-%s.%d-%lx.c", maquina->diretorioTraducao, resumo,
+            getpid(), (unsigned long)(uintptr_t)maquina);
+        snprintf(temporarioBiblioteca, sizeof(temporarioBiblioteca), "%s/poxim-%s.%d-%lx.so", maquina->diretorioTraducao, resumo,
+            getpid(), (unsigned long)(uintptr_t)maquina);
 
-    sprintf(instrucao, "pop ");
-    sprintf(stringResultadoPt1, "{");
-    sprintf(stringResultadoPt2, "}=MEM[0x%08X]{", R[SP]);
+        if(!gerar_traducao_antecipada(maquina, temporarioFonte, palavras)) {
+            fprintf(stderr, "Não foi possível gerar a tradução: %s\n", caminhoFonte);
+            return;
+        }
 
-    if(desempilhar(v)) {
-        registradoresValidos++;
-        formatar_string_registrador(v, registradorV);
-        formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorV);
-        formatar_string_empilhamento_resultado_pt1(stringResultadoPt2, registradoresValidos, R[v]);
-        formatar_string_empilhamento_resultado_pt2(stringResultadoPt1, registradoresValidos, registradorV);
-
-        if(desempilhar(w)) {
-            registradoresValidos++;
-            formatar_string_registrador(w, registradorW);
-            formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorW);
-            formatar_string_empilhamento_resultado_pt1(stringResultadoPt2, registradoresValidos, R[w]);
-            formatar_string_empilhamento_resultado_pt2(stringResultadoPt1, registradoresValidos, registradorW);
-
-            if(desempilhar(x)) {
-                registradoresValidos++;
-                formatar_string_registrador(x, registradorX);
-                formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorX);
-                formatar_string_empilhamento_resultado_pt1(stringResultadoPt2, registradoresValidos, R[x]);
-                formatar_string_empilhamento_resultado_pt2(stringResultadoPt1, registradoresValidos, registradorX);
-
-                if(desempilhar(y)) {
-                    registradoresValidos++;
-                    formatar_string_registrador(y, registradorY);
-                    formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorY);
-                    formatar_string_empilhamento_resultado_pt1(stringResultadoPt2, registradoresValidos, R[y]);
-                    formatar_string_empilhamento_resultado_pt2(stringResultadoPt1, registradoresValidos, registradorY);
-
-                    if(desempilhar(z)) {
-                        registradoresValidos++;
-                        formatar_string_registrador(z, registradorZ);
-                        formatar_string_empilhamento_instrucao(instrucao, registradoresValidos, registradorZ);
-                        formatar_string_empilhamento_resultado_pt1(stringResultadoPt2, registradoresValidos, R[z]);
-                        formatar_string_empilhamento_resultado_pt2(stringResultadoPt1, registradoresValidos, registradorZ);
-                    }
-                }
-            }
+        if(!compilar_traducao_antecipada(temporarioFonte, temporarioBiblioteca) || rename(temporarioFonte, caminhoFonte) ||
+            rename(temporarioBiblioteca, caminhoBiblioteca) ||
+            !(maquina->bibliotecaTraducao = dlopen(caminhoBiblioteca, RTLD_NOW | RTLD_LOCAL))) {
+            fprintf(stderr, "Não foi possível compilar a tradução: %s\n", caminhoFonte);
+            unlink(temporarioFonte);
+            unlink(temporarioBiblioteca);
+            return;
         }
     }
 
-    if(registradoresValidos == 0)
-        formatar_string_empilhamento_instrucao(instrucao, 0, NULL);
+    const uint32_t *quantidade = (const uint32_t *)dlsym(maquina->bibliotecaTraducao, "poximQuantidadeBlocos");
+    const uint32_t *inicios = (const uint32_t *)dlsym(maquina->bibliotecaTraducao, "poximInicios");
+    uint32_t (*const *funcoes)(Poxim *) = (uint32_t (*const *)(Poxim *))dlsym(maquina->bibliotecaTraducao, "poximBlocos");
 
-    sprintf(stringResultado, "%s%s}", stringResultadoPt1, stringResultadoPt2);
-    fprintf(saida, "0x%08X:\t%-25s\t%s\n", pcAtual, instrucao, stringResultado);
-}
-
-void _addi()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
+    if(!quantidade || !inicios || !funcoes) {
+        fprintf(stderr, "Tradução inválida: %s\n", caminhoBiblioteca);
+        dlclose(maquina->bibliotecaTraducao);
+        maquina->bibliotecaTraducao = NULL;
+        return;
+    }
 
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+    // A biblioteca é compartilhada entre as máquinas com a mesma imagem; o estado de cada uma chega pelo vínculo
+    VinculoTraducao vinculo = {
+        maquina->R, maquina->MEM, maquina->palavrasEmBlocos, &maquina->geracaoBlocos, registrar_flags, executar_instrucao_traduzida,
+        invalidar_instrucao_decodificada
+    };
+    maquina->vinculoTraducao = vinculo;
 
-    R[z] = (int32_t)R[x] + i15_i;
+    // Funções indexadas pelo PC inicial, consultadas a cada tradução de bloco
+    maquina->traducoesAntecipadas = (uint32_t (**)(Poxim *))calloc(ENTRADAS_TABELA_BLOCOS, sizeof(uint32_t (*)(Poxim *)));
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+    for(uint32_t i = 0; i < *quantidade; i++)
+        maquina->traducoesAntecipadas[inicios[i] >> 2] = funcoes[i];
+}
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+uint8_t compilar_traducao_antecipada(const char *fonte, const char *biblioteca)
+{
+    // O compilador é executado diretamente, sem shell: os caminhos chegam como argumentos, quaisquer que sejam os seus
+    // caracteres. $CC é separada nos espaços
+    const char *variavel = getenv("CC");
+    char *compilador = strdup(variavel && *variavel ? variavel : COMPILADOR_TRADUCAO);
+    char *argumentos[MAXIMO_ARGUMENTOS_COMPILADOR + 7];
+    int quantidade = 0;
+
+    char *contexto;
+
+    for(char *palavra = strtok_r(compilador, " \t", &contexto); palavra && quantidade < MAXIMO_ARGUMENTOS_COMPILADOR;
+        palavra = strtok_r(NULL, " \t", &contexto))
+        argumentos[quantidade++] = palavra;
+
+    if(!quantidade) {
+        free(compilador);
+        return 0;
+    }
 
-    uint8_t rz31, rx31;
-    rz31 = ((R[z] & 0x80000000) >> 31);
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    const char *opcoes[] = {"-O2", "-shared", "-fPIC", "-o", biblioteca, fonte};
 
-    rx31 = ((R[x] & 0x80000000) >> 31);
-    if(rx31 == i15 && rz31 != rx31)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    for(int i = 0; i < 6; i++)
+        argumentos[quantidade++] = (char *)opcoes[i];
 
-    if(((((uint64_t)R[x] + (uint64_t)i15_i)) >> 32) == 1)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-
-    sprintf(instrucao, "addi %s,%s,%d", registradorZ, registradorX, i15_i);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s+0x%08X=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        i15_i,
-        R[z],
-        R[SR]
-    );
-}
-
-void _subi()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
-
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+    argumentos[quantidade] = NULL;
 
-    R[z] = (int32_t)R[x] - i15_i;
+    pid_t processo;
+    int estado, falha = posix_spawnp(&processo, argumentos[0], NULL, NULL, argumentos, environ);
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+    free(compilador);
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+    if(falha)
+        return 0;
 
-    uint8_t rz31, rx31;
-    rz31 = ((R[z] & 0x80000000) >> 31);
-    if(rz31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    while(waitpid(processo, &estado, 0) < 0)
+        if(errno != EINTR)
+            return 0;
 
-    rx31 = ((R[x] & 0x80000000) >> 31);
-    if(rx31 != i15 && rz31 != rx31)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    return WIFEXITED(estado) && !WEXITSTATUS(estado);
+}
 
-    if(((((uint64_t)R[x] - (uint64_t)i15_i)) >> 32) == 1)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-
-    sprintf(instrucao, "subi %s,%s,%d", registradorZ, registradorX, i15_i);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s-0x%08X=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        i15_i,
-        R[z],
-        R[SR]
-    );
-}
-
-void _muli()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
-
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+uint8_t gerar_traducao_antecipada(Poxim *maquina, const char *caminho, uint32_t palavras)
+{
+    FILE *fonte = fopen(caminho, "w");
+
+    if(!fonte)
+        return 0;
+
+    // Só o início da memória, coberto pela tabela de blocos, é traduzido
+    if(palavras > ENTRADAS_TABELA_BLOCOS)
+        palavras = ENTRADAS_TABELA_BLOCOS;
+
+    uint8_t *visitados = (uint8_t *)calloc(ENTRADAS_TABELA_BLOCOS, sizeof(uint8_t));
+    uint32_t *pendentes = (uint32_t *)malloc(ENTRADAS_TABELA_BLOCOS * sizeof(uint32_t));
+    uint32_t *traduzidos = (uint32_t *)malloc(ENTRADAS_TABELA_BLOCOS * sizeof(uint32_t));
+    uint32_t quantidadePendentes = 0, quantidadeTraduzidos = 0;
+    InstrucaoDecodificada instrucoes[TAMANHO_MAXIMO_BLOCO];
+
+    // Tipos e vínculo com o simulador, que devem corresponder a VinculoTraducao
+    fprintf(fonte,
+        "// Tradução antecipada de uma imagem do POXIM (%u palavras), gerada pelo simulador\n"
+        "#include <stdint.h>\n\n"
+        "struct poxim;\n\n"
+        "typedef struct vinculo_traducao {\n"
+        "    uint32_t *R;\n"
+        "    uint32_t *MEM;\n"
+        "    uint8_t *palavrasEmBlocos;\n"
+        "    uint32_t *geracaoBlocos;\n"
+        "    void (*registrar_flags)(struct poxim *, int, uint8_t, uint8_t, uint8_t, uint8_t, int32_t);\n"
+        "    void (*executar_instrucao)(struct poxim *, uint32_t);\n"
+        "    void (*invalidar_instrucao_decodificada)(struct poxim *, uint32_t);\n"
+        "} VinculoTraducao;\n",
+        palavras);
+
+    // Blocos alcançáveis a partir dos vetores de interrupção (0x00 a 0x1C)
+    for(uint32_t pc = 0; pc <= 0x1C; pc += 4) {
+        visitados[pc >> 2] = 1;
+        pendentes[quantidadePendentes++] = pc;
+    }
 
-    R[z] = (int32_t)R[x] * i15_i;
+    while(quantidadePendentes) {
+        uint32_t inicio = pendentes[--quantidadePendentes], pc = inicio, quantidade = 0;
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+        if((inicio >> 2) >= palavras)
+            continue;
 
-    // Campos afetados
-    if(R[z] == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+        // Mesma divisão em blocos de traduzir_bloco
+        do {
+            decodificar_palavra(&instrucoes[quantidade], maquina->imagemCarregada[pc >> 2], pc);
+            pc += 4;
+        } while(++quantidade < TAMANHO_MAXIMO_BLOCO && (pc >> 2) < ENTRADAS_TABELA_BLOCOS &&
+            !encerra_bloco(instrucoes[quantidade - 1].operacao));
 
-    int32_t rz63_32 = (((int64_t)((int32_t)R[x] * i15_i)) & 0xffffffff00000000) >> 32;
-    if(rz63_32 != 0)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-
-    sprintf(instrucao, "muli %s,%s,%d", registradorZ, registradorX, i15_i);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s*0x%08X=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        i15_i,
-        R[z],
-        R[SR]
-    );
-}
-
-void _divi()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
-
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+        // Sucessores: a instrução seguinte ao bloco (desvio não tomado ou retorno de chamada) e o destino direto
+        InstrucaoDecodificada *ultima = &instrucoes[quantidade - 1];
+        uint32_t sucessores[2] = {pc, ultima->alvo};
+        uint8_t direto = (ultima->operacao >= OP_BAE && ultima->operacao <= OP_BZD) || ultima->operacao == OP_CALLS;
 
-    if(i != 0)
-        R[z] = (int32_t)R[x] / i15_i;
+        for(int i = 0; i < 1 + direto; i++) {
+            uint32_t indice = sucessores[i] >> 2;
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+            if(indice < palavras && !visitados[indice]) {
+                visitados[indice] = 1;
+                pendentes[quantidadePendentes++] = sucessores[i];
+            }
+        }
 
-    // Campos afetados
-    if(R[z] == 0 && i != 0)
-        ativar_flag(ZN);
-    else if(i != 0)
-        desativar_flag(ZN);
+        uint8_t compilavel = 1;
+        for(uint32_t i = 0; i < quantidade; i++)
+            compilavel = compilavel && instrucao_compilavel(&instrucoes[i]);
 
-    if(i == 0) {
-        ativar_flag(ZD);
-
-        if(verificar_flag_setada(IE)) {
-            preparar_execucao_ISR();
-            R[CR] = 0;
-            R[IPC] = R[PC];
-            R[PC] = 0x00000008;
-            R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+        if(compilavel) {
+            gerar_bloco_traduzido(fonte, inicio, instrucoes, quantidade);
+            traduzidos[quantidadeTraduzidos++] = inicio;
         }
-    } else {
-        desativar_flag(ZD);
     }
 
-    desativar_flag(OV);
+    // Tabela de blocos exportada para o simulador
+    fprintf(fonte, "\nconst uint32_t poximQuantidadeBlocos = %u;\n\nconst uint32_t poximInicios[] = {\n", quantidadeTraduzidos);
+    for(uint32_t i = 0; i < quantidadeTraduzidos; i++)
+        fprintf(fonte, "    0x%08X,\n", traduzidos[i]);
+
+    fprintf(fonte, "    0\n};\n\nuint32_t (*const poximBlocos[])(struct poxim *) = {\n");
+    for(uint32_t i = 0; i < quantidadeTraduzidos; i++)
+        fprintf(fonte, "    bloco_%08X,\n", traduzidos[i]);
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+    fprintf(fonte, "    0\n};\n");
 
-    sprintf(instrucao, "divi %s,%s,%d", registradorZ, registradorX, i15_i);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s/0x%08X=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        i15_i,
-        R[z],
-        R[SR]
-    );
+    free(visitados);
+    free(pendentes);
+    free(traduzidos);
 
-    if(verificar_flag_setada(ZD) && verificar_flag_setada(IE))
-        fprintf(saida, "[SOFTWARE INTERRUPTION]\n");
+    return !fclose(fonte);
 }
 
-void _modi()
+void gerar_bloco_traduzido(FILE *fonte, uint32_t pc, InstrucaoDecodificada *instrucoes, uint32_t quantidade)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
-
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+    // O vínculo é o primeiro campo da máquina recebida
+    fprintf(fonte, "\nstatic uint32_t bloco_%08X(struct poxim *maquina)\n{\n", pc);
+    fprintf(fonte, "    const VinculoTraducao *v = (const VinculoTraducao *)maquina;\n");
+    fprintf(fonte, "    uint32_t *R = v->R, *MEM = v->MEM, geracao = *v->geracaoBlocos, indice;\n");
+
+    for(uint32_t i = 0; i < quantidade; i++, pc += 4) {
+        InstrucaoDecodificada *decodificada = &instrucoes[i];
+        uint8_t z = decodificada->z, x = decodificada->x, y = decodificada->y;
+        int32_t imediato = decodificada->imediato;
+
+        fprintf(fonte, "\n    // 0x%08X: 0x%08X\n", pc, decodificada->ir);
+
+        switch(instrucao_nativa(decodificada) ? decodificada->operacao : OP_INVALIDA) {
+            case OP_MOV:
+            case OP_MOVS:
+                if(z)
+                    fprintf(fonte, "    R[%u] = 0x%08Xu;\n", z, imediato);
+                continue;
+
+            case OP_ADD:
+            case OP_SUB:
+            case OP_AND:
+            case OP_OR:
+            case OP_XOR: {
+                const char OPERADORES_C[TOTAL_OPERACOES] = {
+                    [OP_ADD] = '+', [OP_SUB] = '-', [OP_AND] = '&', [OP_OR] = '|', [OP_XOR] = '^'
+                };
+                OperacaoFlags operacao = decodificada->operacao == OP_ADD ? FLAGS_ADD :
+                    decodificada->operacao == OP_SUB ? FLAGS_SUB : FLAGS_LOGICA;
+
+                if(z)
+                    fprintf(fonte, "    R[%u] = R[%u] %c R[%u];\n", z, x, OPERADORES_C[decodificada->operacao], y);
+
+                if(operacao == FLAGS_LOGICA)
+                    fprintf(fonte, "    v->registrar_flags(maquina, %d, %u, 0, 0, 0, 0);\n", operacao, z);
+                else
+                    fprintf(fonte, "    v->registrar_flags(maquina, %d, %u, %u, %u, 0, 0);\n", operacao, z, x, y);
+                continue;
+            }
 
-    if(i != 0)
-        R[z] = (int32_t)R[x] % i15_i;
+            case OP_NOT:
+                if(z)
+                    fprintf(fonte, "    R[%u] = ~R[%u];\n", z, x);
+
+                fprintf(fonte, "    v->registrar_flags(maquina, %d, %u, 0, 0, 0, 0);\n", FLAGS_LOGICA, z);
+                continue;
+
+            case OP_ADDI:
+            case OP_SUBI:
+                if(z)
+                    fprintf(fonte, "    R[%u] = R[%u] %c (uint32_t)%d;\n", z, x, decodificada->operacao == OP_ADDI ? '+' : '-', imediato);
+
+                fprintf(fonte, "    v->registrar_flags(maquina, %d, %u, %u, 0, 0, %d);\n",
+                    decodificada->operacao == OP_ADDI ? FLAGS_ADDI : FLAGS_SUBI, z, x, imediato);
+                continue;
+
+            case OP_CMP:
+                fprintf(fonte, "    v->registrar_flags(maquina, %d, 0, %u, %u, 0, 0);\n", FLAGS_CMP, x, y);
+                continue;
+
+            case OP_CMPI:
+                fprintf(fonte, "    v->registrar_flags(maquina, %d, 0, %u, 0, 0, %d);\n", FLAGS_CMPI, x, imediato);
+                continue;
+
+            case OP_L32:
+            case OP_S32:
+                // Dispositivos, endereços além da tabela de blocos e escritas em código traduzido saem para o interpretador
+                fprintf(fonte, "    indice = R[%u] + (uint32_t)%d;\n", x, (int16_t)imediato);
+                fprintf(fonte, "    if(indice >= %u%s) {\n", ENTRADAS_TABELA_BLOCOS,
+                    decodificada->operacao == OP_S32 ? " || v->palavrasEmBlocos[indice]" : "");
+                gerar_saida_traduzida(fonte, pc, i ? &instrucoes[i - 1] : NULL, i);
+                fprintf(fonte, "    }\n");
+
+                if(decodificada->operacao == OP_S32)
+                    fprintf(fonte, "    MEM[indice] = R[%u];\n    v->invalidar_instrucao_decodificada(maquina, indice);\n", z);
+                else if(z)
+                    fprintf(fonte, "    R[%u] = MEM[indice];\n", z);
+                continue;
+
+            case OP_L8:
+            case OP_S8:
+                // Como em l32 e s32, com o endereço do byte
+                fprintf(fonte, "    indice = R[%u] + (uint32_t)%d;\n", x, (int16_t)imediato);
+                fprintf(fonte, "    if(indice >= %u%s) {\n", ENTRADAS_TABELA_BLOCOS * 4,
+                    decodificada->operacao == OP_S8 ? " || v->palavrasEmBlocos[indice >> 2]" : "");
+                gerar_saida_traduzida(fonte, pc, i ? &instrucoes[i - 1] : NULL, i);
+                fprintf(fonte, "    }\n");
+
+                if(decodificada->operacao == OP_S8)
+                    fprintf(fonte, "    ((uint8_t *)MEM)[indice ^ %u] = (uint8_t)R[%u];\n"
+                        "    v->invalidar_instrucao_decodificada(maquina, indice >> 2);\n", TROCA_BYTE, z);
+                else if(z)
+                    fprintf(fonte, "    R[%u] = ((uint8_t *)MEM)[indice ^ %u];\n", z, TROCA_BYTE);
+                continue;
+
+            case OP_BUN:
+                fprintf(fonte, "    {\n");
+                gerar_saida_traduzida(fonte, decodificada->alvo, decodificada, i + 1);
+                fprintf(fonte, "    }\n");
+                continue;
+
+            default:
+                break;
+        }
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+        // Demais instruções: tratador do interpretador; desvio tomado ou código reescrito encerram o bloco
+        fprintf(fonte, "    v->executar_instrucao(maquina, 0x%08Xu);\n", pc);
+        fprintf(fonte, "    if(R[%u] != 0x%08Xu || *v->geracaoBlocos != geracao) {\n", PC, pc);
+        fprintf(fonte, "        R[%u] += 4;\n        return %u;\n    }\n", PC, i + 1);
+    }
 
-    // Campos afetados
-    if(R[z] == 0 && i != 0)
-        ativar_flag(ZN);
-    else if(i != 0)
-        desativar_flag(ZN);
+    // Fim do bloco sem desvio tomado (depois de um bun inline, o bloco já terminou)
+    InstrucaoDecodificada *ultima = &instrucoes[quantidade - 1];
 
-    if(i == 0) {
-        ativar_flag(ZD);
-
-        if(verificar_flag_setada(IE)) {
-            preparar_execucao_ISR();
-            R[CR] = 0;
-            R[IPC] = R[PC];
-            R[PC] = 0x00000008;
-            R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
-        }
-    } else {
-        desativar_flag(ZD);
+    if(!instrucao_nativa(ultima) || ultima->operacao != OP_BUN) {
+        fprintf(fonte, "\n    {\n");
+        gerar_saida_traduzida(fonte, pc, ultima, quantidade);
+        fprintf(fonte, "    }\n");
     }
 
-    desativar_flag(OV);
+    fprintf(fonte, "}\n");
+}
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+void gerar_saida_traduzida(FILE *fonte, uint32_t pc, InstrucaoDecodificada *ultima, uint32_t executadas)
+{
+    // Mesma saída de jit_saida: PC da próxima instrução e IR da última executada inline
+    fprintf(fonte, "        R[%u] = 0x%08Xu;\n", PC, pc);
 
-    sprintf(instrucao, "modi %s,%s,%d", registradorZ, registradorX, i15_i);
-    fprintf(saida,
-        "0x%08X:\t%-25s\t%s=%s%%0x%08X=0x%08X,SR=0x%08X\n",
-        pcAtual,
-        instrucao,
-        str_upper(registradorZ),
-        str_upper(registradorX),
-        i15_i,
-        R[z],
-        R[SR]
-    );
+    if(ultima && instrucao_nativa(ultima))
+        fprintf(fonte, "        R[%u] = 0x%08Xu;\n", IR, ultima->ir);
 
-    if(verificar_flag_setada(ZD) && verificar_flag_setada(IE))
-        fprintf(saida, "[SOFTWARE INTERRUPTION]\n");
+    fprintf(fonte, "        return %u;\n", executadas);
 }
 
-void _cmpi()
+void executar_instrucao_traduzida(Poxim *maquina, uint32_t pc)
 {
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
+    InstrucaoDecodificada *decodificada = buscar_instrucao(maquina, pc);
 
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+    // PC e IR como o interpretador os deixaria antes do tratador
+    maquina->R[PC] = pc;
+    maquina->R[IR] = decodificada->ir;
+    maquina->pcAtual = pc;
 
-    int64_t cmpi = (int32_t)R[x] - i15_i;
+    decodificada->executar(maquina, decodificada);
+}
 
-    // Campos afetados
-    if(cmpi == 0)
-        ativar_flag(ZN);
-    else
-        desativar_flag(ZN);
+uint32_t (*obter_traducao_antecipada(Poxim *maquina, Bloco *bloco))(Poxim *)
+{
+    if(!maquina->traducoesAntecipadas || !maquina->traducoesAntecipadas[bloco->inicio >> 2])
+        return NULL;
 
-    uint8_t cmpi31 = (cmpi & 0x80000000) >> 31;
-    if(cmpi31 == 1)
-        ativar_flag(SN);
-    else
-        desativar_flag(SN);
+    // A função traduzida só vale enquanto as palavras do bloco forem as da imagem carregada
+    for(uint32_t i = 0; i < bloco->quantidade; i++)
+        if(bloco->instrucoes[i].ir != maquina->imagemCarregada[(bloco->inicio >> 2) + i])
+            return NULL;
 
-    uint8_t rx31 = (R[x] & (0b1 << 31)) >> 31;
-    if(rx31 != i15 && cmpi31 != rx31)
-        ativar_flag(OV);
-    else
-        desativar_flag(OV);
+    return maquina->traducoesAntecipadas[bloco->inicio >> 2];
+}
+#endif
 
-    uint8_t cmpi32 = (cmpi & 0x100000000) >> 32;
-    if(cmpi32 == 1)
-        ativar_flag(CY);
-    else
-        desativar_flag(CY);
+#ifdef PERFIL_SUPERINSTRUCOES
+// Perfil de superinstruções: conta as sequências de 2 a 4 operações executadas em endereços consecutivos.
+// Os perfis de várias imagens são combinados por --superinstructions, que gera o superinstrucoes.h
 
-    // Formatação da saída
-    formatar_string_registrador(x, registradorX);
+void registrar_perfil(Poxim *maquina, Operacao operacao, uint32_t pc)
+{
+    // Um desvio tomado (ou qualquer salto) recomeça a sequência
+    if(pc != maquina->pcAnteriorPerfil + 4)
+        maquina->tamanhoHistoricoPerfil = 0;
+
+    maquina->pcAnteriorPerfil = pc;
+    maquina->historicoPerfil = ((maquina->historicoPerfil << 6) | operacao) & 0xFFFFFF;
 
-    sprintf(instrucao, "cmpi %s,%d", registradorX, i15_i);
-    fprintf(saida, "0x%08X:\t%-25s\tSR=0x%08X\n", pcAtual, instrucao, R[SR]);
+    if(maquina->tamanhoHistoricoPerfil < 4)
+        maquina->tamanhoHistoricoPerfil++;
+
+    for(uint32_t tamanho = 2; tamanho <= maquina->tamanhoHistoricoPerfil; tamanho++)
+        contar_sequencia(maquina->perfil, (tamanho << 24) | (maquina->historicoPerfil & ((0b1 << (6 * tamanho)) - 1)), 1);
 }
 
-void _l8()
+void contar_sequencia(SequenciaPerfil *perfil, uint32_t chave, uint64_t contagem)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint32_t endereco = R[x] + i;
+    uint32_t indice = (chave * 2654435761u) >> 16;
 
-    // TODO: IMPLEMENTAR LEITURA NO TERMINAL
+    // Endereçamento aberto; com a tabela cheia, sequências novas são ignoradas
+    for(int tentativa = 0; tentativa < ENTRADAS_PERFIL; tentativa++, indice = (indice + 1) % ENTRADAS_PERFIL) {
+        if(perfil[indice].chave == chave || !perfil[indice].chave) {
+            perfil[indice].chave = chave;
+            perfil[indice].contagem += contagem;
+            return;
+        }
+    }
+}
 
-    if(endereco == 0x8080888F)
-        R[z] = fpuControle;
-    else
-        R[z] = ((uint8_t *)(&MEM[(endereco) >> 2]))[3 - ((endereco) % 4)];
+Operacao operacao_da_sequencia(uint32_t chave, uint32_t posicao)
+{
+    // A operação mais antiga fica nos bits mais significativos
+    uint32_t tamanho = chave >> 24;
+
+    return (Operacao)((chave >> (6 * (tamanho - 1 - posicao))) & 0b111111);
+}
+
+void gravar_perfil(Poxim *maquina)
+{
+    FILE *arquivo = fopen(maquina->arquivoPerfil, "w");
+
+    if(!arquivo) {
+        fprintf(stderr, "Não foi possível gravar o perfil: %s\n", maquina->arquivoPerfil);
+        return;
+    }
+
+    // Uma sequência por linha: contagem, tamanho e operações, seguidas dos mnemônicos como comentário
+    for(int i = 0; i < ENTRADAS_PERFIL; i++) {
+        if(!maquina->perfil[i].chave)
+            continue;
+
+        uint32_t tamanho = maquina->perfil[i].chave >> 24;
+
+        fprintf(arquivo, "%lu %u", maquina->perfil[i].contagem, tamanho);
+        for(uint32_t posicao = 0; posicao < tamanho; posicao++)
+            fprintf(arquivo, " %u", operacao_da_sequencia(maquina->perfil[i].chave, posicao));
+
+        fprintf(arquivo, " #");
+        for(uint32_t posicao = 0; posicao < tamanho; posicao++)
+            fprintf(arquivo, " %s", nome_tratador(operacao_da_sequencia(maquina->perfil[i].chave, posicao)) + 1);
+
+        fprintf(arquivo, "\n");
+    }
+
+    fclose(arquivo);
+}
+
+const char *nome_operacao(Operacao operacao)
+{
+    // Nome da constante da operação (OP_<nome>), a partir do nome do tratador
+    static _Thread_local char nome[16];
+    int i = 0;
+
+    for(const char *tratador = nome_tratador(operacao) + 1; *tratador && i < 15; tratador++)
+        nome[i++] = *tratador - ('a' <= *tratador && *tratador <= 'z' ? 'a' - 'A' : 0);
+
+    nome[i] = '\0';
+
+    return nome;
+}
+
+const char *nome_tratador(Operacao operacao)
+{
+    // Os tratadores se chamam _<mnemônico>, exceto as duas formas de call e a instrução inválida;
+    // o nome fica em um buffer por thread, já que várias máquinas podem gravar seus perfis ao mesmo tempo
+    static _Thread_local char nome[16];
+
+    if(operacao == OP_CALLF)
+        return "_callf";
+    if(operacao == OP_CALLS)
+        return "_calls";
+
+    snprintf(nome, sizeof(nome), "_%s", MNEMONICOS[operacao]);
+
+    return nome;
+}
+
+uint8_t sequencia_elegivel(uint32_t chave)
+{
+    uint32_t tamanho = chave >> 24;
+
+    for(uint32_t posicao = 0; posicao < tamanho; posicao++) {
+        Operacao operacao = operacao_da_sequencia(chave, posicao);
+
+        // Inválidas e int nunca entram; desvios, chamadas e retornos só podem encerrar a sequência
+        if(operacao >= TOTAL_OPERACOES || operacao == OP_INVALIDA || operacao == OP_INT ||
+            (posicao < tamanho - 1 && operacao >= OP_CALLF && operacao != OP_CBR && operacao != OP_SBR))
+            return 0;
+    }
+
+    return 1;
+}
+
+int comparar_sequencias(const void *a, const void *b)
+{
+    const SequenciaPerfil *x = (const SequenciaPerfil *)a, *y = (const SequenciaPerfil *)b;
+
+    // Ordem decrescente de despachos economizados: contagem vezes (tamanho - 1)
+    uint64_t economiaX = x->contagem * ((x->chave >> 24) - 1), economiaY = y->contagem * ((y->chave >> 24) - 1);
+
+    return economiaX < economiaY ? 1 : economiaX > economiaY ? -1 : 0;
+}
+
+int comparar_tamanhos(const void *a, const void *b)
+{
+    // As mais longas são testadas primeiro pelo decodificador
+    return (int)(((const SequenciaPerfil *)b)->chave >> 24) - (int)(((const SequenciaPerfil *)a)->chave >> 24);
+}
+
+int gerar_superinstrucoes(int argc, char *argv[])
+{
+    if(argc < 4) {
+        fprintf(stderr, "Uso: %s --superinstructions <superinstrucoes.h> <perfil>...\n", argv[0]);
+        return 1;
+    }
+
+    SequenciaPerfil *perfil = (SequenciaPerfil *)calloc(ENTRADAS_PERFIL, sizeof(SequenciaPerfil));
+
+    // Combinando os perfis de todas as imagens
+    for(int i = 3; i < argc; i++) {
+        FILE *arquivo = fopen(argv[i], "r");
+        uint64_t contagem;
+        uint32_t tamanho, operacoes[4];
+
+        if(!arquivo) {
+            fprintf(stderr, "Não foi possível abrir o perfil: %s\n", argv[i]);
+            free(perfil);
+            return 1;
+        }
+
+        while(fscanf(arquivo, "%lu %u", &contagem, &tamanho) == 2 && tamanho >= 2 && tamanho <= 4) {
+            uint32_t chave = tamanho << 24;
+
+            for(uint32_t posicao = 0; posicao < tamanho && fscanf(arquivo, "%u", &operacoes[posicao]) == 1; posicao++)
+                chave |= (operacoes[posicao] & 0b111111) << (6 * (tamanho - 1 - posicao));
+
+            contar_sequencia(perfil, chave, contagem);
+
+            // Comentário com os mnemônicos
+            fscanf(arquivo, "%*[^\n]");
+        }
+
+        fclose(arquivo);
+    }
+
+    // Seleção das sequências que mais economizam despachos
+    uint32_t quantidade = 0;
+    for(int i = 0; i < ENTRADAS_PERFIL; i++)
+        if(perfil[i].chave && sequencia_elegivel(perfil[i].chave))
+            perfil[quantidade++] = perfil[i];
+
+    qsort(perfil, quantidade, sizeof(SequenciaPerfil), comparar_sequencias);
+
+    if(quantidade > MAXIMO_SUPERINSTRUCOES)
+        quantidade = MAXIMO_SUPERINSTRUCOES;
+
+    qsort(perfil, quantidade, sizeof(SequenciaPerfil), comparar_tamanhos);
+
+    FILE *cabecalho = fopen(argv[2], "w");
+
+    if(!cabecalho) {
+        fprintf(stderr, "Não foi possível gravar as superinstruções: %s\n", argv[2]);
+        free(perfil);
+        return 1;
+    }
+
+    fprintf(cabecalho, "// Gerado por --superinstructions a partir de %d perfil(s); regenere em vez de editar\n", argc - 3);
+    fprintf(cabecalho, "// Cada superinstrução encadeia os tratadores das operações, avançando como o laço principal entre elas\n");
+
+    for(uint32_t i = 0; i < quantidade; i++) {
+        uint32_t tamanho = perfil[i].chave >> 24;
+
+        fprintf(cabecalho, "\n// %lu execuções\nvoid _super", perfil[i].contagem);
+        for(uint32_t posicao = 0; posicao < tamanho; posicao++)
+            fprintf(cabecalho, "%s", nome_tratador(operacao_da_sequencia(perfil[i].chave, posicao)));
+
+        fprintf(cabecalho, "(Poxim *maquina, InstrucaoDecodificada *decodificada)\n{\n");
+        for(uint32_t posicao = 0; posicao < tamanho; posicao++) {
+            Operacao operacao = operacao_da_sequencia(perfil[i].chave, posicao);
+
+            if(posicao) {
+                fprintf(cabecalho, "\n    if(!avancar_superinstrucao(maquina, decodificada + %u, OP_%s))\n        return;\n\n", posicao, nome_operacao(operacao));
+                fprintf(cabecalho, "    %s(maquina, decodificada + %u);\n", nome_tratador(operacao), posicao);
+            } else {
+                fprintf(cabecalho, "    %s(maquina, decodificada);\n", nome_tratador(operacao));
+            }
+        }
+        fprintf(cabecalho, "}\n");
+    }
+
+    fprintf(cabecalho, "\nconst Superinstrucao TABELA_SUPERINSTRUCOES[] = {\n");
+    for(uint32_t i = 0; i < quantidade; i++) {
+        uint32_t tamanho = perfil[i].chave >> 24;
+
+        fprintf(cabecalho, "    {%u, {", tamanho);
+        for(uint32_t posicao = 0; posicao < tamanho; posicao++)
+            fprintf(cabecalho, "%sOP_%s", posicao ? ", " : "", nome_operacao(operacao_da_sequencia(perfil[i].chave, posicao)));
+
+        fprintf(cabecalho, "}, _super");
+        for(uint32_t posicao = 0; posicao < tamanho; posicao++)
+            fprintf(cabecalho, "%s", nome_tratador(operacao_da_sequencia(perfil[i].chave, posicao)));
+
+        fprintf(cabecalho, "},\n");
+    }
+    fprintf(cabecalho, "    {0}\n};\n");
+
+    fclose(cabecalho);
+    free(perfil);
+
+    return 0;
+}
+#endif
+
+#ifdef SUPERINSTRUCOES
+uint8_t instalar_superinstrucao(Poxim *maquina, InstrucaoDecodificada *decodificada, uint32_t pc)
+{
+    InstrucaoDecodificada seguinte;
+
+    // A primeira superinstrução (as mais longas vêm antes) cujas operações seguem na memória
+    for(int i = 0; TABELA_SUPERINSTRUCOES[i].tamanho; i++) {
+        const Superinstrucao *superinstrucao = &TABELA_SUPERINSTRUCOES[i];
+        uint8_t corresponde = superinstrucao->operacoes[0] == decodificada->operacao &&
+            entradas_contiguas(pc, superinstrucao->tamanho);
+
+        for(int posicao = 1; corresponde && posicao < superinstrucao->tamanho; posicao++) {
+            decodificar_palavra(&seguinte, maquina->MEM[(pc >> 2) + posicao], pc + 4 * posicao);
+            corresponde = seguinte.operacao == superinstrucao->operacoes[posicao];
+        }
+
+        if(corresponde) {
+            decodificada->executar = superinstrucao->executar;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+uint8_t avancar_superinstrucao(Poxim *maquina, InstrucaoDecodificada *seguinte, Operacao operacao)
+{
+    // Segue para a próxima operação apenas se o laço principal a executaria logo em seguida: sem desvio,
+    // fim da execução ou evento vencido, e com a entrada seguinte ainda decodificada com a operação esperada
+    if(maquina->R[PC] != maquina->pcAtual || !maquina->emExecucao || maquina->instrucoesExecutadas >= maquina->proximoEvento ||
+        !seguinte->valida || seguinte->operacao != operacao || seguinte->usaSR)
+        return 0;
+
+    // Fim da instrução anterior e início da seguinte, como em concluir_instrucao e executar_instrucao
+    maquina->R[PC] = maquina->R[PC] + 4;
+    maquina->instrucoesExecutadas++;
+    maquina->R[IR] = seguinte->ir;
+    maquina->pcAtual = maquina->R[PC];
+
+    return 1;
+}
+#endif
+
+#ifdef DESPACHO_ENCADEADO
+#ifndef __GNUC__
+#error "DESPACHO_ENCADEADO depende de rótulos como valores (computed goto) do GCC/Clang"
+#endif
+
+// Busca a próxima instrução pré-decodificada e salta diretamente para o rótulo da sua operação
+#define DESPACHAR() \
+    do { \
+        if(!maquina->emExecucao) \
+            return; \
+        decodificada = buscar_instrucao(maquina, maquina->R[PC]); \
+        maquina->instrucoesExecutadas++; \
+        if(decodificada->usaSR) { \
+            materializar_flags(maquina); \
+            if(maquina->interrupcoesAgendadas) \
+                agendar_evento(maquina, EVENTO_INTERRUPCOES, maquina->instrucoesExecutadas); \
+        } \
+        maquina->R[IR] = decodificada->ir; \
+        maquina->pcAtual = maquina->R[PC]; \
+        goto *rotulos[decodificada->operacao]; \
+    } while(0)
+
+// Cada rótulo executa a operação e despacha a seguinte sem voltar ao laço da main()
+#define EXECUTAR(tratador) \
+    tratador(maquina, decodificada); \
+    concluir_instrucao(maquina); \
+    DESPACHAR()
+
+void executar_despacho_encadeado(Poxim *maquina)
+{
+    static void *rotulos[TOTAL_OPERACOES] = {
+        [OP_MOV] = &&op_mov,
+        [OP_MOVS] = &&op_movs,
+        [OP_ADD] = &&op_add,
+        [OP_SUB] = &&op_sub,
+        [OP_MUL] = &&op_mul,
+        [OP_SLL] = &&op_sll,
+        [OP_MULS] = &&op_muls,
+        [OP_SLA] = &&op_sla,
+        [OP_DIV] = &&op_div,
+        [OP_SRL] = &&op_srl,
+        [OP_DIVS] = &&op_divs,
+        [OP_SRA] = &&op_sra,
+        [OP_INVALIDA] = &&op_invalida,
+        [OP_CMP] = &&op_cmp,
+        [OP_AND] = &&op_and,
+        [OP_OR] = &&op_or,
+        [OP_NOT] = &&op_not,
+        [OP_XOR] = &&op_xor,
+        [OP_PUSH] = &&op_push,
+        [OP_POP] = &&op_pop,
+        [OP_ADDI] = &&op_addi,
+        [OP_SUBI] = &&op_subi,
+        [OP_MULI] = &&op_muli,
+        [OP_DIVI] = &&op_divi,
+        [OP_MODI] = &&op_modi,
+        [OP_CMPI] = &&op_cmpi,
+        [OP_L8] = &&op_l8,
+        [OP_L16] = &&op_l16,
+        [OP_L32] = &&op_l32,
+        [OP_S8] = &&op_s8,
+        [OP_S16] = &&op_s16,
+        [OP_S32] = &&op_s32,
+        [OP_CALLF] = &&op_callf,
+        [OP_RET] = &&op_ret,
+        [OP_RETI] = &&op_reti,
+        [OP_CBR] = &&op_cbr,
+        [OP_SBR] = &&op_sbr,
+        [OP_BAE] = &&op_bae,
+        [OP_BAT] = &&op_bat,
+        [OP_BBE] = &&op_bbe,
+        [OP_BBT] = &&op_bbt,
+        [OP_BEQ] = &&op_beq,
+        [OP_BGE] = &&op_bge,
+        [OP_BGT] = &&op_bgt,
+        [OP_BIV] = &&op_biv,
+        [OP_BLE] = &&op_ble,
+        [OP_BLT] = &&op_blt,
+        [OP_BNE] = &&op_bne,
+        [OP_BNI] = &&op_bni,
+        [OP_BNZ] = &&op_bnz,
+        [OP_BUN] = &&op_bun,
+        [OP_BZD] = &&op_bzd,
+        [OP_CALLS] = &&op_calls,
+        [OP_INT] = &&op_int
+    };
+    InstrucaoDecodificada *decodificada;
+
+    DESPACHAR();
+
+op_mov: EXECUTAR(_mov);
+op_movs: EXECUTAR(_movs);
+op_add: EXECUTAR(_add);
+op_sub: EXECUTAR(_sub);
+op_mul: EXECUTAR(_mul);
+op_sll: EXECUTAR(_sll);
+op_muls: EXECUTAR(_muls);
+op_sla: EXECUTAR(_sla);
+op_div: EXECUTAR(_div);
+op_srl: EXECUTAR(_srl);
+op_divs: EXECUTAR(_divs);
+op_sra: EXECUTAR(_sra);
+op_invalida: EXECUTAR(retornar_instrucao_invalida);
+op_cmp: EXECUTAR(decodificada->executar);
+op_and: EXECUTAR(_and);
+op_or: EXECUTAR(_or);
+op_not: EXECUTAR(_not);
+op_xor: EXECUTAR(_xor);
+op_push: EXECUTAR(_push);
+op_pop: EXECUTAR(_pop);
+op_addi: EXECUTAR(_addi);
+op_subi: EXECUTAR(_subi);
+op_muli: EXECUTAR(_muli);
+op_divi: EXECUTAR(_divi);
+op_modi: EXECUTAR(_modi);
+op_cmpi: EXECUTAR(decodificada->executar);
+op_l8: EXECUTAR(_l8);
+op_l16: EXECUTAR(_l16);
+op_l32: EXECUTAR(_l32);
+op_s8: EXECUTAR(_s8);
+op_s16: EXECUTAR(_s16);
+op_s32: EXECUTAR(_s32);
+op_callf: EXECUTAR(_callf);
+op_ret: EXECUTAR(_ret);
+op_reti: EXECUTAR(_reti);
+op_cbr: EXECUTAR(_cbr);
+op_sbr: EXECUTAR(_sbr);
+op_bae: EXECUTAR(_bae);
+op_bat: EXECUTAR(_bat);
+op_bbe: EXECUTAR(_bbe);
+op_bbt: EXECUTAR(_bbt);
+op_beq: EXECUTAR(_beq);
+op_bge: EXECUTAR(_bge);
+op_bgt: EXECUTAR(_bgt);
+op_biv: EXECUTAR(_biv);
+op_ble: EXECUTAR(_ble);
+op_blt: EXECUTAR(_blt);
+op_bne: EXECUTAR(_bne);
+op_bni: EXECUTAR(_bni);
+op_bnz: EXECUTAR(_bnz);
+op_bun: EXECUTAR(_bun);
+op_bzd: EXECUTAR(_bzd);
+op_calls: EXECUTAR(_calls);
+op_int: EXECUTAR(_int);
+}
+
+#undef EXECUTAR
+#undef DESPACHAR
+#endif
+
+uint64_t resumir_palavra(uint64_t resumo, uint32_t palavra)
+{
+    // FNV-1a de 64 bits, byte a byte a partir do menos significativo
+    for(int byte = 0; byte < 4; byte++) {
+        resumo ^= (palavra >> (8 * byte)) & 0xFF;
+        resumo *= 0x100000001B3;
+    }
+
+    return resumo;
+}
+
+uint64_t resumir_palavras(uint64_t resumo, const uint32_t *palavras, uint32_t quantidade)
+{
+    for(uint32_t i = 0; i < quantidade; i++)
+        resumo = resumir_palavra(resumo, palavras[i]);
+
+    return resumo;
+}
+
+void registrar_desempenho(Poxim *maquina, struct timespec *inicio)
+{
+    struct timespec fim;
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    double segundos = (fim.tv_sec - inicio->tv_sec) + (fim.tv_nsec - inicio->tv_nsec) / 1e9;
+
+    fprintf(maquina->debug, "Instruções executadas: %lu\n", maquina->instrucoesExecutadas);
+    fprintf(maquina->debug, "Tempo de execução: %.6f s\n", segundos);
+    fprintf(maquina->debug, "Instruções por segundo: %.0f\n", segundos > 0 ? maquina->instrucoesExecutadas / segundos : 0);
+}
+
+void _mov(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint32_t xyl = decodificada->imediato;
+    uint8_t z = decodificada->z;
+
+    maquina->R[z] = xyl;
 
     // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+    maquina->R[0] = 0;
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
 
-    sprintf(instrucao, "l8 %s,[%s%s%d]", registradorZ, registradorX, (i >= 0) ? ("+") : (""), i);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=MEM[0x%08X]=0x%02X\n", pcAtual, instrucao, str_upper(registradorZ), endereco, R[z]);
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z]}};
+    emitir_passo(maquina, &passo);
 }
 
-void _l16()
+void _movs(Poxim *maquina, InstrucaoDecodificada *decodificada)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
+    uint8_t z = decodificada->z;
 
-    R[z] = ((uint16_t *)(&MEM[(R[x] + i) >> 1]))[1 - ((R[x] + i) % 2)];
+    maquina->R[z] = decodificada->imediato;
 
     // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+    maquina->R[0] = 0;
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
 
-    sprintf(instrucao, "l16 %s,[%s%s%d]", registradorZ, registradorX, (i >= 0) ? ("+") : (""), i);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=MEM[0x%08X]=0x%04X\n", pcAtual, instrucao, str_upper(registradorZ), (R[x] + i) << 1, R[z]);
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z]}};
+    emitir_passo(maquina, &passo);
 }
 
-void _l32()
+void _add(Poxim *maquina, InstrucaoDecodificada *decodificada)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint32_t endereco = (R[x] + i) << 2;
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
 
-    if(endereco == 0x80808880)
-        R[z] = fpuX_IEEE754 ? fpuX.u : fpuX.f;
-    else if(endereco == 0x80808884)
-        R[z] = fpuY_IEEE754 ? fpuY.u : fpuY.f;
-    else if(endereco == 0x80808888) {
-        if(fpuZ_IEEE754)
-            memcpy(&R[z], &fpuZ.u, sizeof(uint32_t));
-        else
-            R[z] = fpuZ.f;
-    } 
-    else if(endereco == 0x8080888C)
-        R[z] = fpuControle;
-    else
-        R[z] = MEM[R[x] + i];
+    maquina->R[z] = maquina->R[x] + maquina->R[y];
 
     // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
+    maquina->R[0] = 0;
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_ADD, z, x, y, 0, 0);
 
-    sprintf(instrucao, "l32 %s,[%s%s%d]", registradorZ, registradorX, (i >= 0) ? ("+") : (""), i);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=MEM[0x%08X]=0x%08X\n", pcAtual, instrucao, str_upper(registradorZ), endereco, R[z]);
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
 }
 
-void _s8()
+void _sub(Poxim *maquina, InstrucaoDecodificada *decodificada)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint32_t endereco = R[x] + i;
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
 
-    if(endereco == 0x8888888B)
-        adicionar_caractere_output((char)R[z]);
-    else if(endereco == 0x8080888F)
-        fpuControle = R[z];
-    else
-        ((uint8_t *)&MEM[(endereco) >> 2])[3 - (endereco) % 4] = (uint8_t)R[z];
+    maquina->R[z] = maquina->R[x] - maquina->R[y];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_SUB, z, x, y, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _mul(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+
+    maquina->R[l4_0] = (((uint64_t)maquina->R[x] * (uint64_t)maquina->R[y]) & (0xFFFFFFFF00000000)) >> 32;
+    maquina->R[z] = maquina->R[x] * maquina->R[y];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_MUL, z, 0, 0, l4_0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[l4_0], maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _sll(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+    uint64_t rzy = (((uint64_t)maquina->R[z]) << 32) | maquina->R[y];
+
+    maquina->R[z] = ((rzy * (potencia(2, (l4_0 + 1)))) & (0xFFFFFFFF00000000)) >> 32;
+    maquina->R[x] = (rzy * (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_DESLOCAMENTO, z, x, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[x], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _muls(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+    int64_t rx64, ry64;
+
+    rx64 = (int64_t)(int32_t)maquina->R[x];
+    ry64 = (int64_t)(int32_t)maquina->R[y];
+
+    maquina->R[l4_0] = ((rx64 * ry64) & 0xFFFFFFFF00000000) >> 32;
+    maquina->R[z] = (rx64 * ry64) & 0xFFFFFFFF;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_MULS, z, 0, 0, l4_0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[l4_0], maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _sla(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+    int64_t rzy = (((int64_t)maquina->R[z]) << 32) | maquina->R[y];
+
+    maquina->R[z] = ((rzy * (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF00000000) >> 32;
+    maquina->R[x] = ((uint64_t)rzy * (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_DESLOCAMENTO_ARITMETICO, z, x, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[x], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _div(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+
+    // Operandos lidos antes das escritas: l ou z podem ser o próprio x ou y (um y zerado pelo resto dividiria por 0)
+    uint32_t dividendo = maquina->R[x];
+    uint32_t divisor = maquina->R[y];
+
+    if(divisor) {
+        maquina->R[l4_0] = dividendo % divisor;
+        maquina->R[z] = dividendo / divisor;
+    }
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados
+    if(maquina->R[z] == 0 && divisor)
+        ativar_flag(maquina, ZN);
+    else if(divisor)
+        desativar_flag(maquina, ZN);
+
+    if(divisor == 0) {
+        ativar_flag(maquina, ZD);
+
+        if(verificar_flag_setada(maquina, IE)) {
+            preparar_execucao_ISR(maquina);
+            maquina->R[CR] = 0;
+            maquina->R[IPC] = maquina->R[PC];
+            maquina->R[PC] = 0x00000008;
+            maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+        }
+    } else {
+        desativar_flag(maquina, ZD);
+    }
+
+    if(maquina->R[l4_0] != 0)
+        ativar_flag(maquina, CY);
+    else if(divisor)
+        desativar_flag(maquina, CY);
+
+    // Registro do passo no trace
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[l4_0], maquina->R[z], maquina->R[SR]}};
+        emitir_passo(maquina, &passo);
+    }
+
+    if(verificar_flag_setada(maquina, ZD) && verificar_flag_setada(maquina, IE))
+        registrar_interrupcao_software(maquina);
+}
+
+void _srl(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+    uint64_t rzy = (((uint64_t)maquina->R[z]) << 32) | maquina->R[y];
+
+    maquina->R[z] = ((rzy / (potencia(2, (l4_0 + 1)))) & (0xFFFFFFFF00000000)) >> 32;
+    maquina->R[x] = (rzy / (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_DESLOCAMENTO, z, x, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[x], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _divs(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+
+    // Operandos lidos antes das escritas, como em div
+    int32_t dividendo = maquina->R[x];
+    int32_t divisor = maquina->R[y];
+
+    // Divisão em 64 bits: 0x80000000 / -1 (quociente fora de 32 bits, exceção no hospedeiro) resulta em 0x80000000, resto 0
+    if(divisor) {
+        maquina->R[l4_0] = (int64_t)dividendo % divisor;
+        maquina->R[z] = (int64_t)dividendo / divisor;
+    }
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados
+    if(maquina->R[z] == 0 && divisor)
+        ativar_flag(maquina, ZN);
+    else if(divisor)
+        desativar_flag(maquina, ZN);
+
+    if(divisor == 0) {
+        ativar_flag(maquina, ZD);
+
+        if(verificar_flag_setada(maquina, IE)) {
+            preparar_execucao_ISR(maquina);
+            maquina->R[CR] = 0;
+            maquina->R[IPC] = maquina->R[PC];
+            maquina->R[PC] = 0x00000008;
+            maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+        }
+    } else {
+        desativar_flag(maquina, ZD);
+    }
+
+    if(maquina->R[l4_0] != 0)
+        ativar_flag(maquina, OV);
+    else if(divisor)
+        desativar_flag(maquina, OV);
+
+    // Registro do passo no trace
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[l4_0], maquina->R[z], maquina->R[SR]}};
+        emitir_passo(maquina, &passo);
+    }
+
+    if(verificar_flag_setada(maquina, ZD) && verificar_flag_setada(maquina, IE))
+        registrar_interrupcao_software(maquina);
+}
+
+void _sra(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l4_0 = decodificada->l;
+    int64_t rzy = (((int64_t)maquina->R[z]) << 32) | maquina->R[y];
+
+    maquina->R[z] = ((rzy / (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF00000000) >> 32;
+    maquina->R[x] = ((uint64_t)rzy / (potencia(2, (l4_0 + 1)))) & 0xFFFFFFFF;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_DESLOCAMENTO_ARITMETICO, z, x, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[x], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _cmp(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_CMP, 0, x, y, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _and(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+
+    maquina->R[z] = maquina->R[x] & maquina->R[y];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_LOGICA, z, 0, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _or(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+
+    maquina->R[z] = maquina->R[x] | maquina->R[y];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_LOGICA, z, 0, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _not(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+
+    maquina->R[z] = ~maquina->R[x];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_LOGICA, z, 0, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _xor(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+
+    maquina->R[z] = maquina->R[x] ^ maquina->R[y];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_LOGICA, z, 0, 0, 0, 0);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _push(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    // Registradores na ordem de empilhamento (v, w, x, y, z), encerrada no primeiro R0
+    uint8_t registradores[5] = {decodificada->v, decodificada->l, decodificada->x, decodificada->y, decodificada->z};
+    uint32_t valores[5];
+    uint32_t spAtual = maquina->R[SP];
+    uint8_t registradoresValidos = 0;
+
+    while(registradoresValidos < 5 && empilhar(maquina, registradores[registradoresValidos])) {
+        valores[registradoresValidos] = maquina->R[registradores[registradoresValidos]];
+        registradoresValidos++;
+    }
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace: SP inicial seguido dos valores transferidos
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {spAtual}};
+    memcpy(&passo.valores[1], valores, registradoresValidos * sizeof(uint32_t));
+    emitir_passo(maquina, &passo);
+}
+
+void _pop(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    // Registradores na ordem de desempilhamento (v, w, x, y, z), encerrada no primeiro R0
+    uint8_t registradores[5] = {decodificada->v, decodificada->l, decodificada->x, decodificada->y, decodificada->z};
+    uint32_t valores[5];
+    uint32_t spAtual = maquina->R[SP];
+    uint8_t registradoresValidos = 0;
+
+    while(registradoresValidos < 5 && desempilhar(maquina, registradores[registradoresValidos])) {
+        valores[registradoresValidos] = maquina->R[registradores[registradoresValidos]];
+        registradoresValidos++;
+    }
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace: SP inicial seguido dos valores transferidos
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {spAtual}};
+    memcpy(&passo.valores[1], valores, registradoresValidos * sizeof(uint32_t));
+    emitir_passo(maquina, &passo);
+}
+
+void _addi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int32_t i15_i = decodificada->imediato;
+
+    maquina->R[z] = (int32_t)maquina->R[x] + i15_i;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_ADDI, z, x, 0, 0, i15_i);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _subi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int32_t i15_i = decodificada->imediato;
+
+    maquina->R[z] = (int32_t)maquina->R[x] - i15_i;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_SUBI, z, x, 0, 0, i15_i);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _muli(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int32_t i15_i = decodificada->imediato;
+
+    maquina->R[z] = (int32_t)maquina->R[x] * i15_i;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_MULI, z, x, 0, 0, i15_i);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _divi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    int32_t i15_i = decodificada->imediato;
+
+    int32_t dividendo = maquina->R[x];
+
+    // Divisão em 64 bits, como em divs: 0x80000000 / -1 resulta em 0x80000000
+    if(i != 0)
+        maquina->R[z] = (int64_t)dividendo / i15_i;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados
+    if(maquina->R[z] == 0 && i != 0)
+        ativar_flag(maquina, ZN);
+    else if(i != 0)
+        desativar_flag(maquina, ZN);
+
+    if(i == 0) {
+        ativar_flag(maquina, ZD);
+
+        if(verificar_flag_setada(maquina, IE)) {
+            preparar_execucao_ISR(maquina);
+            maquina->R[CR] = 0;
+            maquina->R[IPC] = maquina->R[PC];
+            maquina->R[PC] = 0x00000008;
+            maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+        }
+    } else {
+        desativar_flag(maquina, ZD);
+    }
+
+    desativar_flag(maquina, OV);
+
+    // Registro do passo no trace
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+        emitir_passo(maquina, &passo);
+    }
+
+    if(verificar_flag_setada(maquina, ZD) && verificar_flag_setada(maquina, IE))
+        registrar_interrupcao_software(maquina);
+}
+
+void _modi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    int32_t i15_i = decodificada->imediato;
+
+    int32_t dividendo = maquina->R[x];
+
+    // Resto em 64 bits, como em divs: 0x80000000 % -1 resulta em 0
+    if(i != 0)
+        maquina->R[z] = (int64_t)dividendo % i15_i;
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    // Campos afetados
+    if(maquina->R[z] == 0 && i != 0)
+        ativar_flag(maquina, ZN);
+    else if(i != 0)
+        desativar_flag(maquina, ZN);
+
+    if(i == 0) {
+        ativar_flag(maquina, ZD);
+
+        if(verificar_flag_setada(maquina, IE)) {
+            preparar_execucao_ISR(maquina);
+            maquina->R[CR] = 0;
+            maquina->R[IPC] = maquina->R[PC];
+            maquina->R[PC] = 0x00000008;
+            maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+        }
+    } else {
+        desativar_flag(maquina, ZD);
+    }
+
+    desativar_flag(maquina, OV);
+
+    // Registro do passo no trace
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z], maquina->R[SR]}};
+        emitir_passo(maquina, &passo);
+    }
+
+    if(verificar_flag_setada(maquina, ZD) && verificar_flag_setada(maquina, IE))
+        registrar_interrupcao_software(maquina);
+}
+
+void _cmpi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t x = decodificada->x;
+    int32_t i15_i = decodificada->imediato;
+
+    // Campos afetados (calculados apenas quando o SR for lido)
+    registrar_flags(maquina, FLAGS_CMPI, 0, x, 0, 0, i15_i);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    materializar_flags(maquina);
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[SR]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _cmp_desvio(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    // Par fundido pelo decodificador: o desvio condicional é a entrada seguinte da cache
+    InstrucaoDecodificada *desvio = decodificada + 1;
+    uint32_t rx = maquina->R[decodificada->x];
+    uint32_t ry = maquina->R[decodificada->y];
+
+    // A comparação é executada normalmente: as flags continuam registradas para o trace e leituras posteriores do SR
+    tratadores[decodificada->operacao](maquina, decodificada);
+
+    // O desvio só é executado junto se nenhum evento vencer entre as duas instruções
+    // e a sua entrada ainda estiver decodificada (uma escrita na memória pode tê-la invalidado)
+    if(maquina->instrucoesExecutadas >= maquina->proximoEvento || !desvio->valida || !desvio_fundivel(desvio->operacao))
+        return;
+
+    // Fim da comparação e início do desvio, como em concluir_instrucao e executar_instrucao
+    maquina->R[PC] = maquina->R[PC] + 4;
+    maquina->instrucoesExecutadas++;
+    maquina->R[IR] = desvio->ir;
+    maquina->pcAtual = maquina->R[PC];
+
+    // Condição avaliada a partir dos operandos, sem calcular o SR
+    if(condicao_comparacao(decodificada, rx, ry, desvio->operacao))
+        maquina->R[PC] = desvio->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo do desvio no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, desvio->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+uint8_t desvio_fundivel(Operacao operacao)
+{
+    // Desvios que dependem apenas de ZN, SN, OV e CY, todas escritas por cmp e cmpi
+    switch(operacao) {
+        case OP_BAE:
+        case OP_BAT:
+        case OP_BBE:
+        case OP_BBT:
+        case OP_BEQ:
+        case OP_BGE:
+        case OP_BGT:
+        case OP_BLE:
+        case OP_BLT:
+        case OP_BNE:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+uint8_t condicao_comparacao(InstrucaoDecodificada *comparacao, uint32_t rx, uint32_t ry, Operacao desvio)
+{
+    uint8_t zn, sn, ov, cy;
+    uint8_t rx31 = rx >> 31;
+
+    // Mesmas flags calculadas por materializar_flags para FLAGS_CMP e FLAGS_CMPI
+    if(comparacao->operacao == OP_CMP) {
+        uint64_t cmp = (uint64_t)rx - (uint64_t)ry;
+
+        zn = cmp == 0;
+        sn = (cmp & 0x80000000) >> 31;
+        ov = rx31 != ry >> 31 && sn != rx31;
+        cy = (cmp >> 32) & 0b1;
+    } else {
+        int64_t cmpi = (int32_t)(rx - (uint32_t)comparacao->imediato);
+        uint8_t i15 = (int16_t)comparacao->imediato >> 15;
+
+        zn = cmpi == 0;
+        sn = (cmpi & 0x80000000) >> 31;
+        ov = rx31 != i15 && sn != rx31;
+        cy = (cmpi & 0x100000000) >> 32;
+    }
+
+    switch(desvio) {
+        case OP_BAE: return cy == 0;
+        case OP_BAT: return zn == 0 && cy == 0;
+        case OP_BBE: return zn == 1 || cy == 1;
+        case OP_BBT: return cy == 1;
+        case OP_BEQ: return zn == 1;
+        case OP_BGE: return sn == ov;
+        case OP_BGT: return zn == 0 && sn == ov;
+        case OP_BLE: return zn == 1 || sn != ov;
+        case OP_BLT: return sn != ov;
+        case OP_BNE: return zn == 0;
+        default: return 0;
+    }
+}
+
+void _l8(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    uint32_t endereco = maquina->R[x] + i;
+
+    if(endereco - maquina->inicioBarramento > maquina->extensaoBarramento || !ler_barramento(maquina, endereco, 1, &maquina->R[z]))
+        maquina->R[z] = ((uint8_t *)maquina->MEM)[endereco ^ TROCA_BYTE];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {endereco, maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _l16(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    uint32_t endereco = (maquina->R[x] + i) << 1;
+
+    maquina->R[z] = ((uint16_t *)maquina->MEM)[(endereco >> 1) ^ TROCA_MEIA_PALAVRA];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {endereco, maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _l32(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    uint32_t endereco = (maquina->R[x] + i) << 2;
+
+    if(endereco - maquina->inicioBarramento > maquina->extensaoBarramento || !ler_barramento(maquina, endereco, 4, &maquina->R[z]))
+        maquina->R[z] = maquina->MEM[endereco >> 2];
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {endereco, maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _s8(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    uint32_t endereco = maquina->R[x] + i;
+
+    if(endereco - maquina->inicioBarramento > maquina->extensaoBarramento || !escrever_barramento(maquina, endereco, 1, maquina->R[z])) {
+        ((uint8_t *)maquina->MEM)[endereco ^ TROCA_BYTE] = (uint8_t)maquina->R[z];
+        invalidar_instrucao_decodificada(maquina, endereco >> 2);
+    }
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {endereco, maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _s16(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    uint32_t endereco = (maquina->R[x] + i) << 1;
+
+    ((uint16_t *)maquina->MEM)[(endereco >> 1) ^ TROCA_MEIA_PALAVRA] = (int16_t)maquina->R[z];
+    invalidar_instrucao_decodificada(maquina, endereco >> 2);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {endereco, maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _s32(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    int16_t i = decodificada->imediato;
+    uint32_t endereco = (maquina->R[x] + i) << 2;
+
+    if(endereco - maquina->inicioBarramento > maquina->extensaoBarramento || !escrever_barramento(maquina, endereco, 4, maquina->R[z])) {
+        maquina->MEM[endereco >> 2] = maquina->R[z];
+        invalidar_instrucao_decodificada(maquina, endereco >> 2);
+    }
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {endereco, maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _callf(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t x = decodificada->x;
+    int32_t i15_i = decodificada->imediato;
+    uint32_t spAtual = maquina->R[SP];
+
+    maquina->MEM[maquina->R[SP] >> 2] = maquina->R[PC] + 4;
+    invalidar_instrucao_decodificada(maquina, maquina->R[SP] >> 2);
+    maquina->R[SP] -= 4;
+    maquina->R[PC] = ((int32_t)maquina->R[x] + i15_i) << 2;
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4, spAtual}};
+    emitir_passo(maquina, &passo);
+}
+
+void _ret(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    maquina->R[SP] += 4;
+    maquina->R[PC] = maquina->MEM[maquina->R[SP] >> 2];
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[SP], maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _reti(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint32_t sp_ipc, sp_cr;
+
+    maquina->R[SP] += 4;
+    sp_ipc = maquina->R[SP];
+    maquina->R[IPC] = maquina->MEM[maquina->R[SP] >> 2];
+
+    maquina->R[SP] += 4;
+    sp_cr = maquina->R[SP];
+    maquina->R[CR] = maquina->MEM[maquina->R[SP] >> 2];
+
+    maquina->R[SP] += 4;
+    maquina->R[PC] = maquina->MEM[maquina->R[SP] >> 2];
+
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {sp_ipc, maquina->R[IPC], sp_cr, maquina->R[CR], maquina->R[SP], maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _cbr(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+
+    maquina->R[z] = maquina->R[z] & ~(0b1 << x);
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _sbr(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+
+    maquina->R[z] = maquina->R[z] | (0b1 << x);
+
+    // R[0] não pode armazenar um valor diferente de 0
+    maquina->R[0] = 0;
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[z]}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bae(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t cy = maquina->R[SR] & 0b1;
+
+    if(cy == 0)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bat(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t cy = maquina->R[SR] & 0b1;
+    uint8_t zn = (maquina->R[SR] & (0b1 << 6)) >> 6;
+
+    if(zn == 0 && cy == 0)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bbe(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t cy = maquina->R[SR] & 0b1;
+    uint8_t zn = (maquina->R[SR] & (0b1 << 6)) >> 6;
+
+    if(zn == 1 || cy == 1)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bbt(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t cy = maquina->R[SR] & 0b1;
+
+    if(cy == 1)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _beq(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t zn = (maquina->R[SR] & (0b1 << 6)) >> 6;
+
+    if(zn == 1)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bge(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t sn = (maquina->R[SR] & (0b1 << 4)) >> 4;
+    uint8_t ov = (maquina->R[SR] & (0b1 << 3)) >> 3;
+
+    if(sn == ov)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bgt(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t zn = (maquina->R[SR] & (0b1 << 6)) >> 6;
+    uint8_t sn = (maquina->R[SR] & (0b1 << 4)) >> 4;
+    uint8_t ov = (maquina->R[SR] & (0b1 << 3)) >> 3;
+
+    if(zn == 0 && sn == ov)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _biv(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t iv = (maquina->R[SR] & (0b1 << 2)) >> 2;
+
+    if(iv)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _ble(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t zn = (maquina->R[SR] & (0b1 << 6)) >> 6;
+    uint8_t sn = (maquina->R[SR] & (0b1 << 4)) >> 4;
+    uint8_t ov = (maquina->R[SR] & (0b1 << 3)) >> 3;
+
+    if(zn == 1 || sn != ov)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _blt(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t sn = (maquina->R[SR] & (0b1 << 4)) >> 4;
+    uint8_t ov = (maquina->R[SR] & (0b1 << 3)) >> 3;
+
+    if(sn != ov)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bne(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    materializar_flags(maquina);
+
+    uint8_t zn = (maquina->R[SR] & (0b1 << 6)) >> 6;
+
+    if(zn == 0)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bni(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t iv = (maquina->R[SR] & (0b1 << 2)) >> 2;
+
+    if(iv == 0)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bnz(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t zd = (maquina->R[SR] & (0b1 << 5)) >> 5;
+
+    if(zd == 0)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bun(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    maquina->R[PC] = decodificada->alvo;
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _bzd(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint8_t zd = (maquina->R[SR] & (0b1 << 5)) >> 5;
+
+    if(zd)
+        maquina->R[PC] = decodificada->alvo - 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4}};
+    emitir_passo(maquina, &passo);
+}
+
+void _calls(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint32_t spAtual = maquina->R[SP];
+
+    maquina->MEM[maquina->R[SP] >> 2] = maquina->R[PC] + 4;
+    invalidar_instrucao_decodificada(maquina, maquina->R[SP] >> 2);
+    maquina->R[SP] -= 4;
+    maquina->R[PC] = decodificada->alvo;
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+
+    if(maquina->modoTrace != TRACE_COMPLETO)
+        return;
+
+    // Registro do passo no trace
+    PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[PC] + 4, spAtual}};
+    emitir_passo(maquina, &passo);
+}
+
+void _int(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    uint32_t i = decodificada->imediato;
+
+    if(!i) {
+        maquina->emExecucao = 0;
+    } else {
+        preparar_execucao_ISR(maquina);
+        maquina->R[CR] = i;
+        maquina->R[IPC] = maquina->R[PC];
+        maquina->R[PC] = 0x0000000C;
+        maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    }
+
+    // Registro do passo no trace
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INSTRUCAO, maquina->pcAtual, decodificada->ir, {maquina->R[CR], maquina->R[PC] + 4}};
+        emitir_passo(maquina, &passo);
+    }
+
+    if(i)
+        registrar_interrupcao_software(maquina);
+}
+
+uint8_t empilhar(Poxim *maquina, uint8_t i)
+{
+    if(i != 0) {
+        maquina->MEM[maquina->R[SP] >> 2] = maquina->R[i];
+        invalidar_instrucao_decodificada(maquina, maquina->R[SP] >> 2);
+        maquina->R[SP] -= 4;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+uint8_t desempilhar(Poxim *maquina, uint8_t i)
+{
+    if(i != 0) {
+        maquina->R[SP] += 4;
+        maquina->R[i] = maquina->MEM[maquina->R[SP] >> 2];
+
+        return 1;
+    }
+
+    return 0;
+}
+
+uint8_t interpretar_opcoes(Poxim *maquina, int argc, char *argv[])
+{
+    if(argc < 3) {
+        fprintf(stderr, "Uso: %s <entrada.hex> <saida.out> [--trace=off|terminal|full|binary | --no-trace]\n", argv[0]);
+        fprintf(stderr, "     %s --render <trace.bin> <saida.out> [--window=INICIO:QUANTIDADE]\n", argv[0]);
+        fprintf(stderr, "     %s --pack <entrada.hex> <imagem.bin>\n", argv[0]);
+#ifdef EXECUCAO_EM_LOTE
+        fprintf(stderr, "     %s --batch <manifesto> [--threads=N] [opções]\n", argv[0]);
+#endif
+#ifdef SERVIDOR
+        fprintf(stderr, "     %s --serve <soquete> [--threads=N] [opções]\n", argv[0]);
+#endif
+#ifdef TRADUCAO_ANTECIPADA
+        fprintf(stderr, "     opção adicional: --aot=<diretório> (tradução antecipada da imagem)\n");
+#endif
+#ifdef CACHE_RESULTADOS
+        fprintf(stderr, "     opções adicionais: --cache=<diretório> [--cache-size=<MiB>] | --no-cache (cache de resultados)\n");
+#endif
+#ifdef PERFIL_SUPERINSTRUCOES
+        fprintf(stderr, "     opção adicional: --profile=<arquivo> (perfil de sequências de operações)\n");
+        fprintf(stderr, "     %s --superinstructions <superinstrucoes.h> <perfil>...\n", argv[0]);
+#endif
+        return 0;
+    }
+
+    // Trace completo, exceto se alterado pelas opções
+    poxim_set_trace(maquina, POXIM_TRACE_FULL);
+
+    // Opções a partir do terceiro argumento
+    for(int i = 3; i < argc; i++) {
+#ifdef TRADUCAO_ANTECIPADA
+        // Diretório da tradução antecipada da imagem (não altera o modo de trace)
+        if(!strncmp(argv[i], "--aot=", 6)) {
+            maquina->diretorioTraducao = argv[i] + 6;
+            continue;
+        }
+#endif
+
+#ifdef CACHE_RESULTADOS
+        // Cache de resultados: diretório, limite do tamanho e desvio da cache (não alteram o modo de trace)
+        if(!strncmp(argv[i], "--cache=", 8)) {
+            maquina->diretorioResultados = argv[i] + 8;
+            continue;
+        }
+
+        if(!strncmp(argv[i], "--cache-size=", 13)) {
+            char *fim;
+            unsigned long megabytes = strtoul(argv[i] + 13, &fim, 10);
+
+            if(fim == argv[i] + 13 || *fim) {
+                fprintf(stderr, "Tamanho de cache inválido: %s\n", argv[i]);
+                return 0;
+            }
+
+            maquina->limiteResultados = (uint64_t)megabytes * 1024 * 1024;
+            continue;
+        }
+
+        if(!strcmp(argv[i], "--no-cache")) {
+            maquina->cacheIgnorada = 1;
+            continue;
+        }
+#endif
+
+#ifdef PERFIL_SUPERINSTRUCOES
+        // Arquivo do perfil de sequências de operações (não altera o modo de trace)
+        if(!strncmp(argv[i], "--profile=", 10)) {
+            maquina->arquivoPerfil = argv[i] + 10;
+            continue;
+        }
+#endif
+
+        if(!strcmp(argv[i], "--trace=off") || !strcmp(argv[i], "--no-trace")) {
+            poxim_set_trace(maquina, POXIM_TRACE_OFF);
+        } else if(!strcmp(argv[i], "--trace=terminal")) {
+            poxim_set_trace(maquina, POXIM_TRACE_TERMINAL);
+        } else if(!strcmp(argv[i], "--trace=full")) {
+            poxim_set_trace(maquina, POXIM_TRACE_FULL);
+        } else if(!strcmp(argv[i], "--trace=binary")) {
+            poxim_set_trace(maquina, POXIM_TRACE_BINARY);
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", argv[i]);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int renderizar_trace_binario(int argc, char *argv[])
+{
+    char assinatura[sizeof(ASSINATURA_TRACE_BINARIO)];
+    uint32_t tamanhoRegistro;
+    uint64_t inicioJanela = 0, quantidadeJanela = UINT64_MAX;
+    uint8_t janela = 0;
+
+    if(argc != 4 && argc != 5) {
+        fprintf(stderr, "Uso: %s --render <trace.bin> <saida.out> [--window=INICIO:QUANTIDADE]\n", argv[0]);
+        return 1;
+    }
+
+    // Janela opcional, em registros a partir do início do trace
+    if(argc == 5) {
+        if(sscanf(argv[4], "--window=%" SCNu64 ":%" SCNu64, &inicioJanela, &quantidadeJanela) != 2) {
+            fprintf(stderr, "Opção desconhecida: %s\n", argv[4]);
+            return 1;
+        }
+
+        janela = 1;
+    }
+
+    FILE *trace = fopen(argv[2], "rb");
+
+    if(!trace) {
+        fprintf(stderr, "Não foi possível abrir o trace: %s\n", argv[2]);
+        return 1;
+    }
+
+    // O cabeçalho identifica o formato e o tamanho dos registros com que o trace foi gravado
+    if(fread(assinatura, sizeof(char), sizeof(assinatura), trace) != sizeof(assinatura) ||
+        memcmp(assinatura, ASSINATURA_TRACE_BINARIO, sizeof(assinatura)) ||
+        fread(&tamanhoRegistro, sizeof(uint32_t), 1, trace) != 1 || tamanhoRegistro != sizeof(PassoTrace)) {
+        fprintf(stderr, "Trace binário inválido: %s\n", argv[2]);
+        fclose(trace);
+        return 1;
+    }
+
+    FILE *saida = fopen(argv[3], "w");
+
+    if(!saida) {
+        fprintf(stderr, "Não foi possível abrir o arquivo de saída: %s\n", argv[3]);
+        fclose(trace);
+        return 1;
+    }
+
+    // Máquina usada apenas pelo trace: buffer, cache de desmontagem e arquivo de saída
+    Poxim *maquina = criar_maquina();
+    maquina->saida = saida;
+
+    inicializar_trace(maquina);
+
+    // Uma janela não inclui as mensagens de início e fim da simulação
+    if(!janela) {
+        trace_iniciar_linha(maquina);
+        trace_texto(maquina, "[START OF SIMULATION]\n");
+    }
+
+    PassoTrace passo;
+    uint64_t indice = 0;
+    uint8_t completo = 0;
+
+    // Até o registro de fim, que confere a quantidade de registros lidos. Sem ele (ou com um registro ou o
+    // conteúdo do terminal incompleto), o trace foi truncado
+    while(fread(&passo, sizeof(PassoTrace), 1, trace) == 1) {
+        uint8_t naJanela = indice >= inicioJanela && indice - inicioJanela < quantidadeJanela;
+
+        if(passo.tipo == PASSO_FIM) {
+            completo = (((uint64_t)passo.valores[1] << 32) | passo.valores[0]) == indice;
+            break;
+        }
+
+        if(passo.tipo == PASSO_TERMINAL) {
+            // O conteúdo do terminal vem logo após o registro
+            char *conteudo = (char *)malloc(passo.valores[0] * sizeof(char) + 1);
+            uint32_t tamanhoConteudo = fread(conteudo, sizeof(char), passo.valores[0], trace);
+
+            if(tamanhoConteudo != passo.valores[0]) {
+                free(conteudo);
+                break;
+            }
+
+            if(naJanela) {
+                trace_descarregar(maquina);
+
+                fprintf(maquina->saida, "[TERMINAL]\n");
+                fwrite(conteudo, sizeof(char), tamanhoConteudo, maquina->saida);
+                fprintf(maquina->saida, "\n");
+            }
+
+            free(conteudo);
+        } else if(naJanela) {
+            trace_iniciar_linha(maquina);
+            renderizar_passo(maquina, &passo);
+        }
+
+        indice++;
+    }
+
+    if(!janela && completo) {
+        trace_iniciar_linha(maquina);
+        trace_texto(maquina, "[END OF SIMULATION]\n");
+    }
+
+    trace_descarregar(maquina);
+
+    if(!completo)
+        fprintf(stderr, "Trace binário truncado: %s (%" PRIu64 " registros lidos)\n", argv[2], indice);
+
+    fclose(trace);
+    fclose(maquina->saida);
+
+    free(maquina->bufferTrace);
+    free(maquina->cacheDesmontagem);
+    free(maquina);
+
+    return !completo;
+}
+
+#if defined(EXECUCAO_EM_LOTE) || defined(SERVIDOR)
+char **separar_opcoes_paralelas(int argc, char *argv[], int *argcOpcoes, long *totalThreads)
+{
+    // Opções do simulador repassadas a cada máquina, sem --threads; a partir da terceira, como em interpretar_opcoes
+    char **opcoes = (char **)malloc(argc * sizeof(char *));
+
+    *argcOpcoes = 3;
+    memcpy(opcoes, argv, 3 * sizeof(char *));
+
+    *totalThreads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    for(int i = 3; i < argc; i++) {
+        if(!strncmp(argv[i], "--threads=", 10)) {
+            if(sscanf(argv[i] + 10, "%ld", totalThreads) != 1 || *totalThreads < 1) {
+                fprintf(stderr, "Quantidade de threads inválida: %s\n", argv[i]);
+                free(opcoes);
+                return NULL;
+            }
+        } else {
+            opcoes[(*argcOpcoes)++] = argv[i];
+        }
+    }
+
+    // Validando as opções uma única vez, antes de criar as máquinas
+    Poxim *modelo = poxim_create();
+    uint8_t opcoesValidas = interpretar_opcoes(modelo, *argcOpcoes, opcoes);
+
+#ifdef PERFIL_SUPERINSTRUCOES
+    // Todas as máquinas gravariam o mesmo arquivo de perfil
+    if(opcoesValidas && modelo->arquivoPerfil) {
+        fprintf(stderr, "A opção --profile não pode ser usada com %s\n", argv[1]);
+        opcoesValidas = 0;
+    }
+#endif
+
+    poxim_destroy(modelo);
+
+    if(!opcoesValidas) {
+        free(opcoes);
+        return NULL;
+    }
+
+    return opcoes;
+}
+#endif
+
+#ifdef EXECUCAO_EM_LOTE
+int executar_lote(int argc, char *argv[])
+{
+    Lote lote = {0};
+    long totalTrabalhadores;
+
+    if(argc < 3) {
+        fprintf(stderr, "Uso: %s --batch <manifesto> [--threads=N] [opções]\n", argv[0]);
+        return 1;
+    }
+
+    lote.argv = separar_opcoes_paralelas(argc, argv, &lote.argc, &totalTrabalhadores);
+
+    if(!lote.argv)
+        return 1;
+
+    FILE *manifesto = fopen(argv[2], "r");
+
+    if(!manifesto) {
+        fprintf(stderr, "Não foi possível abrir o manifesto: %s\n", argv[2]);
+        free(lote.argv);
+        return 1;
+    }
+
+    // Um par "<entrada> <saída>" por linha; linhas vazias e iniciadas por # são ignoradas
+    uint32_t capacidade = 64;
+    char *linha = NULL, *entrada, *saida;
+    size_t tamanhoLinha = 0;
+
+    lote.trabalhos = (TrabalhoLote *)malloc(capacidade * sizeof(TrabalhoLote));
+
+    for(uint32_t numeroLinha = 1; getline(&linha, &tamanhoLinha, manifesto) != -1; numeroLinha++) {
+        int campos = sscanf(linha, " %ms %ms", &entrada, &saida);
+
+        if(campos < 1 || entrada[0] == '#') {
+            if(campos >= 1)
+                free(entrada);
+            if(campos == 2)
+                free(saida);
+            continue;
+        }
+
+        if(campos != 2) {
+            fprintf(stderr, "Linha %u do manifesto sem arquivo de saída: %s\n", numeroLinha, entrada);
+            free(entrada);
+            continue;
+        }
+
+        if(lote.totalTrabalhos == capacidade) {
+            capacidade *= 2;
+            lote.trabalhos = (TrabalhoLote *)realloc(lote.trabalhos, capacidade * sizeof(TrabalhoLote));
+        }
+
+        lote.trabalhos[lote.totalTrabalhos++] = (TrabalhoLote){entrada, saida, 0, {0, 0}, 0, 0};
+    }
+
+    free(linha);
+    fclose(manifesto);
+
+    // Mais trabalhadores que trabalhos só criaria threads ociosas
+    if(totalTrabalhadores > lote.totalTrabalhos)
+        totalTrabalhadores = lote.totalTrabalhos ? lote.totalTrabalhos : 1;
+
+    lote.totalTrabalhadores = (int)totalTrabalhadores;
+
+    // Trabalhos distribuídos em intervalos contíguos de tamanhos iguais (diferindo em no máximo 1)
+    lote.filas = (FilaLote *)aligned_alloc(_Alignof(FilaLote), lote.totalTrabalhadores * sizeof(FilaLote));
+
+    for(int i = 0; i < lote.totalTrabalhadores; i++) {
+        pthread_mutex_init(&lote.filas[i].trava, NULL);
+        lote.filas[i].inicio = (uint64_t)lote.totalTrabalhos * i / lote.totalTrabalhadores;
+        lote.filas[i].fim = (uint64_t)lote.totalTrabalhos * (i + 1) / lote.totalTrabalhadores;
+    }
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    // A thread principal é o trabalhador 0
+    pthread_t *threads = (pthread_t *)malloc(lote.totalTrabalhadores * sizeof(pthread_t));
+    TrabalhadorLote *trabalhadores = (TrabalhadorLote *)malloc(lote.totalTrabalhadores * sizeof(TrabalhadorLote));
+
+    for(int i = 0; i < lote.totalTrabalhadores; i++)
+        trabalhadores[i] = (TrabalhadorLote){&lote, i};
+
+    for(int i = 1; i < lote.totalTrabalhadores; i++)
+        pthread_create(&threads[i], NULL, executar_trabalhador_lote, &trabalhadores[i]);
+
+    executar_trabalhador_lote(&trabalhadores[0]);
+
+    for(int i = 1; i < lote.totalTrabalhadores; i++)
+        pthread_join(threads[i], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    // Relatório na ordem do manifesto: entrada, saída, instruções executadas e tempo de parede de cada trabalho
+    uint64_t totalInstrucoes = 0;
+    uint32_t falhas = 0;
+
+    printf("# entrada\tsaída\tinstruções\tsegundos\n");
+    for(uint32_t i = 0; i < lote.totalTrabalhos; i++) {
+        TrabalhoLote *trabalho = &lote.trabalhos[i];
+
+        if(trabalho->concluido) {
+            printf("%s\t%s\t%lu\t%.6f\n", trabalho->entrada, trabalho->saida, trabalho->instrucoes, trabalho->segundos);
+            totalInstrucoes += trabalho->instrucoes;
+        } else {
+            printf("%s\t%s\tfalha\t-\n", trabalho->entrada, trabalho->saida);
+            falhas++;
+        }
+
+        free(trabalho->entrada);
+        free(trabalho->saida);
+    }
+
+    double segundos = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+
+    printf("# %u trabalhos (%u falhas) em %d threads: %lu instruções em %.6f s, %.0f instruções por segundo\n",
+        lote.totalTrabalhos, falhas, lote.totalTrabalhadores, totalInstrucoes, segundos,
+        segundos > 0 ? totalInstrucoes / segundos : 0);
+
+    for(int i = 0; i < lote.totalTrabalhadores; i++)
+        pthread_mutex_destroy(&lote.filas[i].trava);
+
+    free(threads);
+    free(trabalhadores);
+    free(lote.filas);
+    free(lote.trabalhos);
+    free(lote.argv);
+
+    return falhas ? 1 : 0;
+}
+
+void *executar_trabalhador_lote(void *argumento)
+{
+    TrabalhadorLote *trabalhador = (TrabalhadorLote *)argumento;
+    uint32_t indice;
+
+#ifdef EXECUCAO_VETORIAL
+    // Até PISTAS_VETORIAIS trabalhos por vez, executados juntos pelo motor vetorial (sem AVX2, um de cada vez).
+    // Um grupo incompleto significa que não restam trabalhos em nenhuma fila
+    if(__builtin_cpu_supports("avx2")) {
+        uint32_t indices[PISTAS_VETORIAIS], quantidade;
+
+        do {
+            for(quantidade = 0; quantidade < (uint32_t)PISTAS_VETORIAIS &&
+                obter_trabalho_lote(trabalhador->lote, trabalhador->indice, &indices[quantidade]); quantidade++);
+
+            if(quantidade)
+                executar_trabalhos_vetoriais(trabalhador->lote, indices, quantidade);
+        } while(quantidade == (uint32_t)PISTAS_VETORIAIS);
+
+        return NULL;
+    }
+#endif
+
+    while(obter_trabalho_lote(trabalhador->lote, trabalhador->indice, &indice))
+        executar_trabalho_lote(trabalhador->lote, &trabalhador->lote->trabalhos[indice]);
+
+    return NULL;
+}
+
+uint8_t obter_trabalho_lote(Lote *lote, int trabalhador, uint32_t *indice)
+{
+    FilaLote *fila = &lote->filas[trabalhador];
+
+    // Próximo trabalho da própria fila
+    pthread_mutex_lock(&fila->trava);
+    if(fila->inicio < fila->fim) {
+        *indice = fila->inicio++;
+        pthread_mutex_unlock(&fila->trava);
+        return 1;
+    }
+    pthread_mutex_unlock(&fila->trava);
+
+    // Fila vazia: rouba a metade final da primeira fila com trabalhos, a partir da seguinte. Como nenhum
+    // trabalho novo é criado, uma volta completa sem encontrar trabalhos encerra o trabalhador
+    for(int i = 1; i < lote->totalTrabalhadores; i++) {
+        FilaLote *vitima = &lote->filas[(trabalhador + i) % lote->totalTrabalhadores];
+        uint32_t inicioRoubo, fimRoubo;
+
+        pthread_mutex_lock(&vitima->trava);
+        if(vitima->inicio >= vitima->fim) {
+            pthread_mutex_unlock(&vitima->trava);
+            continue;
+        }
+
+        fimRoubo = vitima->fim;
+        inicioRoubo = vitima->fim - (vitima->fim - vitima->inicio + 1) / 2;
+        vitima->fim = inicioRoubo;
+        pthread_mutex_unlock(&vitima->trava);
+
+        // O primeiro trabalho roubado é executado agora; o restante passa a ser a própria fila
+        pthread_mutex_lock(&fila->trava);
+        fila->inicio = inicioRoubo + 1;
+        fila->fim = fimRoubo;
+        pthread_mutex_unlock(&fila->trava);
+
+        *indice = inicioRoubo;
+        return 1;
+    }
+
+    return 0;
+}
+
+void executar_trabalho_lote(Lote *lote, TrabalhoLote *trabalho)
+{
+    Poxim *maquina = preparar_trabalho_lote(lote, trabalho);
+
+    if(!maquina)
+        return;
+
+    poxim_run(maquina, POXIM_SEM_LIMITE);
+
+    concluir_trabalho_lote(trabalho, maquina);
+}
+
+Poxim *preparar_trabalho_lote(Lote *lote, TrabalhoLote *trabalho)
+{
+    clock_gettime(CLOCK_MONOTONIC, &trabalho->inicio);
+
+    // Cada trabalho em sua própria máquina, com as opções da linha de comando já validadas
+    Poxim *maquina = poxim_create();
+    Imagem imagem;
+
+    interpretar_opcoes(maquina, lote->argc, lote->argv);
+
+    if(!ler_imagem(trabalho->entrada, &imagem)) {
+        poxim_destroy(maquina);
+        return NULL;
+    }
+
+#ifdef CACHE_RESULTADOS
+    // Saída copiada da cache: nenhuma instrução executada
+    if(restaurar_resultado(maquina, imagem.palavras, imagem.quantidade, trabalho->saida)) {
+        liberar_imagem(&imagem);
+        poxim_destroy(maquina);
+        concluir_trabalho_lote(trabalho, NULL);
+        return NULL;
+    }
+#endif
+
+    if(poxim_set_output(maquina, trabalho->saida) || poxim_load_image(maquina, imagem.palavras, imagem.quantidade)) {
+        liberar_imagem(&imagem);
+        poxim_destroy(maquina);
+        return NULL;
+    }
+
+    liberar_imagem(&imagem);
+
+    return maquina;
+}
+
+void concluir_trabalho_lote(TrabalhoLote *trabalho, Poxim *maquina)
+{
+    struct timespec fim;
+
+    if(maquina) {
+        trabalho->instrucoes = poxim_instructions(maquina);
+        poxim_destroy(maquina);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    trabalho->segundos = (fim.tv_sec - trabalho->inicio.tv_sec) + (fim.tv_nsec - trabalho->inicio.tv_nsec) / 1e9;
+    trabalho->concluido = 1;
+}
+#endif
+
+#ifdef EXECUCAO_VETORIAL
+// Motor vetorial do lote: a cada passo, as pistas ativas com o menor PC executam juntas a instrução desse
+// endereço. Desvios divergentes separam as pistas em PCs distintos; escolher sempre o menor PC faz as que
+// ficaram para trás alcançarem as outras, e as pistas se reúnem onde os caminhos voltam a se encontrar.
+// Operações aritméticas, lógicas, comparações e deslocamentos usam AVX2; l32, s32 e desvios são avaliados
+// pista a pista sem sair do grupo. As demais instruções, as dos eventos agendados e todas as do trace
+// completo são executadas pelo tratador, na máquina da pista
+
+void executar_trabalhos_vetoriais(Lote *lote, uint32_t *indices, uint32_t quantidade)
+{
+    GrupoVetorial *grupo = (GrupoVetorial *)aligned_alloc(_Alignof(GrupoVetorial), sizeof(GrupoVetorial));
+    TrabalhoLote *trabalhos[PISTAS_VETORIAIS];
+    int pistas = 0;
+
+    memset(grupo, 0, sizeof(GrupoVetorial));
+    grupo->geracao = 1;
+
+    // Trabalhos sem máquina (falha ao carregar ou resultado da cache) não ocupam pista. No trace completo cada
+    // instrução é registrada pelo tratador: o trabalho é executado sozinho, como sem o motor vetorial
+    for(uint32_t i = 0; i < quantidade; i++) {
+        Poxim *maquina = preparar_trabalho_lote(lote, &lote->trabalhos[indices[i]]);
+
+        if(!maquina)
+            continue;
+
+        if(maquina->modoTrace == TRACE_COMPLETO) {
+            poxim_run(maquina, POXIM_SEM_LIMITE);
+            concluir_trabalho_lote(&lote->trabalhos[indices[i]], maquina);
+            continue;
+        }
+
+        trabalhos[pistas] = &lote->trabalhos[indices[i]];
+        grupo->maquinas[pistas] = maquina;
+        grupo->ativas |= 0b1 << pistas;
+        carregar_pista(grupo, pistas);
+        pistas++;
+    }
+
+    executar_grupo_vetorial(grupo);
+
+    // O tempo de cada trabalho vai da sua carga ao fim do grupo inteiro
+    for(int pista = 0; pista < pistas; pista++)
+        concluir_trabalho_lote(trabalhos[pista], grupo->maquinas[pista]);
+
+    free(grupo);
+}
+
+__attribute__((target("avx2")))
+void executar_grupo_vetorial(GrupoVetorial *grupo)
+{
+    const __m256i bitsPistas = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+
+    while(grupo->ativas) {
+        // Menor PC entre as pistas ativas; as inativas valem o maior endereço possível
+        __m256i ativas = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(grupo->ativas), bitsPistas), bitsPistas);
+        __m256i pcs = _mm256_or_si256(_mm256_load_si256((__m256i *)grupo->R[PC]), _mm256_xor_si256(ativas, _mm256_set1_epi32(-1)));
+        __m256i minimo = _mm256_min_epu32(pcs, _mm256_permute2x128_si256(pcs, pcs, 1));
+
+        minimo = _mm256_min_epu32(minimo, _mm256_shuffle_epi32(minimo, _MM_SHUFFLE(1, 0, 3, 2)));
+        minimo = _mm256_min_epu32(minimo, _mm256_shuffle_epi32(minimo, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        uint32_t mascara = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(pcs, minimo))) & grupo->ativas;
+        uint32_t escalares = executar_passo_vetorial(grupo, _mm256_cvtsi256_si32(minimo), mascara);
+
+        // Pistas cuja instrução fica com o tratador, uma de cada vez
+        for(; escalares; escalares &= escalares - 1)
+            executar_pista_escalar(grupo, __builtin_ctz(escalares));
+    }
+}
+
+__attribute__((target("avx2")))
+uint32_t executar_passo_vetorial(GrupoVetorial *grupo, uint32_t pc, uint32_t mascara)
+{
+    Poxim *lider = grupo->maquinas[__builtin_ctz(mascara)];
+    uint32_t entrada = (pc >> 2) & (32 * 1024 / 4 - 1);
+
+    // PC desalinhado: o destino dos desvios depende do PC real, e as pistas seguem pelo tratador
+    if(pc & 3)
+        return mascara;
+
+    InstrucaoDecodificada *instrucao = obter_instrucao(lider, pc);
+
+    if(!instrucao->valida)
+        decodificar_instrucao(lider, instrucao, pc);
+
+    // Pistas cuja próxima instrução é a de um evento agendado ficam com o tratador
+    uint32_t escalares = mascara & _mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(_mm256_load_si256((__m256i *)grupo->folga), _mm256_setzero_si256())));
+
+    // Palavra ainda não comparada nesta geração: só as pistas com a mesma palavra do líder (imagens distintas ou
+    // código reescrito separam as pistas) executam a instrução juntas. Apenas instruções vetoriais são marcadas
+    if(grupo->palavrasIguais[entrada] != grupo->geracao || grupo->pcsIguais[entrada] != pc) {
+        uint32_t diferentes = 0;
+
+        if(!instrucao_vetorial(instrucao))
+            return mascara;
+
+        for(uint32_t resto = grupo->ativas; resto; resto &= resto - 1) {
+            int pista = __builtin_ctz(resto);
+
+            if(grupo->maquinas[pista]->MEM[pc >> 2] != instrucao->ir)
+                diferentes |= 0b1 << pista;
+        }
+
+        if(!diferentes) {
+            grupo->palavrasIguais[entrada] = grupo->geracao;
+            grupo->pcsIguais[entrada] = pc;
+        }
+
+        escalares |= mascara & diferentes;
+    }
+
+    if(mascara & ~escalares)
+        escalares |= executar_operacao_vetorial(grupo, instrucao, mascara & ~escalares);
+
+    return escalares;
+}
+
+__attribute__((target("avx2")))
+uint32_t executar_operacao_vetorial(GrupoVetorial *grupo, InstrucaoDecodificada *instrucao, uint32_t mascara)
+{
+    const __m256i bitsPistas = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i pistas = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(mascara), bitsPistas), bitsPistas);
+    __m256i rx = _mm256_load_si256((__m256i *)grupo->R[instrucao->x]);
+    __m256i ry = _mm256_load_si256((__m256i *)grupo->R[instrucao->y]);
+    __m256i imediato = _mm256_set1_epi32(instrucao->imediato);
+    __m256i resultado = _mm256_setzero_si256();
+    OperacaoFlags flags = FLAGS_MATERIALIZADAS;
+    uint8_t escreve = 1;
+    uint32_t escalares = 0;
+
+    switch(instrucao->operacao) {
+        case OP_MOV:
+        case OP_MOVS:
+            resultado = imediato;
+            break;
+        case OP_ADD:
+            resultado = _mm256_add_epi32(rx, ry);
+            flags = FLAGS_ADD;
+            break;
+        case OP_SUB:
+            resultado = _mm256_sub_epi32(rx, ry);
+            flags = FLAGS_SUB;
+            break;
+        case OP_AND:
+            resultado = _mm256_and_si256(rx, ry);
+            flags = FLAGS_LOGICA;
+            break;
+        case OP_OR:
+            resultado = _mm256_or_si256(rx, ry);
+            flags = FLAGS_LOGICA;
+            break;
+        case OP_XOR:
+            resultado = _mm256_xor_si256(rx, ry);
+            flags = FLAGS_LOGICA;
+            break;
+        case OP_NOT:
+            resultado = _mm256_xor_si256(rx, _mm256_set1_epi32(-1));
+            flags = FLAGS_LOGICA;
+            break;
+        case OP_ADDI:
+            resultado = _mm256_add_epi32(rx, imediato);
+            flags = FLAGS_ADDI;
+            break;
+        case OP_SUBI:
+            resultado = _mm256_sub_epi32(rx, imediato);
+            flags = FLAGS_SUBI;
+            break;
+        case OP_CMP:
+            escreve = 0;
+            flags = FLAGS_CMP;
+            break;
+        case OP_CMPI:
+            escreve = 0;
+            flags = FLAGS_CMPI;
+            break;
+        case OP_SLL:
+        case OP_SRL:
+        case OP_SLA:
+            escreve = 0;
+            deslocar_vetorial(grupo, instrucao, pistas);
+            flags = instrucao->operacao == OP_SLA ? FLAGS_DESLOCAMENTO_ARITMETICO : FLAGS_DESLOCAMENTO;
+            break;
+        case OP_SRA:
+            // Sem deslocamento aritmético de 64 bits no AVX2: a mesma divisão do tratador, pista a pista
+            escreve = 0;
+            for(uint32_t resto = mascara; resto; resto &= resto - 1) {
+                int pista = __builtin_ctz(resto);
+                int64_t rzy = (((int64_t)grupo->R[instrucao->z][pista]) << 32) | grupo->R[instrucao->y][pista];
+
+                grupo->R[instrucao->z][pista] = ((rzy / (potencia(2, (instrucao->l + 1)))) & 0xFFFFFFFF00000000) >> 32;
+                grupo->R[instrucao->x][pista] = ((uint64_t)rzy / (potencia(2, (instrucao->l + 1)))) & 0xFFFFFFFF;
+                grupo->R[0][pista] = 0;
+            }
+            flags = FLAGS_DESLOCAMENTO_ARITMETICO;
+            break;
+        case OP_L32:
+        case OP_S32:
+            escreve = 0;
+            escalares = acessar_memoria_vetorial(grupo, instrucao, mascara);
+            break;
+        default:
+            // Desvios: tomado, o PC fica 4 antes do destino, como nos tratadores
+            escreve = 0;
+            _mm256_store_si256((__m256i *)grupo->R[PC], _mm256_blendv_epi8(_mm256_load_si256((__m256i *)grupo->R[PC]),
+                _mm256_set1_epi32(instrucao->alvo - 4), _mm256_and_si256(pistas, desvios_tomados(instrucao->operacao,
+                _mm256_load_si256((__m256i *)grupo->R[SR])))));
+            break;
+    }
+
+    // R[0] não pode armazenar um valor diferente de 0
+    if(escreve && instrucao->z) {
+        __m256i rz = _mm256_load_si256((__m256i *)grupo->R[instrucao->z]);
+        _mm256_store_si256((__m256i *)grupo->R[instrucao->z], _mm256_blendv_epi8(rz, resultado, pistas));
+    }
+
+    // Flags calculadas com os operandos depois da escrita, como em materializar_flags
+    if(flags != FLAGS_MATERIALIZADAS) {
+        __m256i sr = _mm256_load_si256((__m256i *)grupo->R[SR]);
+        __m256i novas = flags_vetoriais(flags,
+            _mm256_load_si256((__m256i *)grupo->R[instrucao->z]),
+            _mm256_load_si256((__m256i *)grupo->R[instrucao->x]),
+            _mm256_load_si256((__m256i *)grupo->R[instrucao->y]), instrucao->imediato);
+
+        novas = _mm256_or_si256(_mm256_andnot_si256(_mm256_set1_epi32(FLAGS_AFETADAS[flags]), sr), novas);
+        _mm256_store_si256((__m256i *)grupo->R[SR], _mm256_blendv_epi8(sr, novas, pistas));
+    }
+
+    // Fim da instrução nas pistas executadas: PC seguinte, IR e contagem (as máscaras valem -1 por pista)
+    pistas = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(mascara & ~escalares), bitsPistas), bitsPistas);
+
+    __m256i pc = _mm256_load_si256((__m256i *)grupo->R[PC]);
+    __m256i ir = _mm256_load_si256((__m256i *)grupo->R[IR]);
+
+    _mm256_store_si256((__m256i *)grupo->R[PC], _mm256_add_epi32(pc, _mm256_and_si256(pistas, _mm256_set1_epi32(4))));
+    _mm256_store_si256((__m256i *)grupo->R[IR], _mm256_blendv_epi8(ir, _mm256_set1_epi32(instrucao->ir), pistas));
+    _mm256_store_si256((__m256i *)grupo->executadas, _mm256_sub_epi32(_mm256_load_si256((__m256i *)grupo->executadas), pistas));
+    _mm256_store_si256((__m256i *)grupo->folga, _mm256_add_epi32(_mm256_load_si256((__m256i *)grupo->folga), pistas));
+
+    return escalares;
+}
+
+__attribute__((target("avx2")))
+__m256i flags_vetoriais(OperacaoFlags operacao, __m256i rz, __m256i rx, __m256i ry, int32_t imediato)
+{
+    // As mesmas flags de materializar_flags em todas as pistas: cada condição é uma máscara (-1 ou 0) e os bits 31
+    // viram máscaras pelo deslocamento aritmético
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i sinal = _mm256_set1_epi32(0x80000000);
+    __m256i zn = _mm256_cmpeq_epi32(rz, zero), sn = _mm256_srai_epi32(rz, 31), ov = zero, cy = zero, diferenca, soma;
+
+    switch(operacao) {
+        case FLAGS_ADD:
+            // Estouro com operandos de mesmo sinal; vai-um se a soma de 32 bits for menor que um operando
+            soma = _mm256_add_epi32(rx, ry);
+            ov = _mm256_srai_epi32(_mm256_andnot_si256(_mm256_xor_si256(rx, ry), _mm256_xor_si256(rz, rx)), 31);
+            cy = _mm256_cmpgt_epi32(_mm256_xor_si256(rx, sinal), _mm256_xor_si256(soma, sinal));
+            break;
+        case FLAGS_SUB:
+            ov = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(rx, ry), _mm256_xor_si256(rz, rx)), 31);
+            cy = _mm256_cmpgt_epi32(_mm256_xor_si256(ry, sinal), _mm256_xor_si256(rx, sinal));
+            break;
+        case FLAGS_CMP:
+            diferenca = _mm256_sub_epi32(rx, ry);
+            zn = _mm256_cmpeq_epi32(rx, ry);
+            sn = _mm256_srai_epi32(diferenca, 31);
+            ov = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(rx, ry), _mm256_xor_si256(diferenca, rx)), 31);
+            cy = _mm256_cmpgt_epi32(_mm256_xor_si256(ry, sinal), _mm256_xor_si256(rx, sinal));
+            break;
+        case FLAGS_ADDI:
+            // Com o imediato negativo, OV e CY nunca são ativadas (o imediato estendido a 64 bits não gera vai-um)
+            if(imediato >= 0) {
+                soma = _mm256_add_epi32(rx, _mm256_set1_epi32(imediato));
+                ov = _mm256_srai_epi32(_mm256_andnot_si256(rx, rz), 31);
+                cy = _mm256_cmpgt_epi32(_mm256_xor_si256(rx, sinal), _mm256_xor_si256(soma, sinal));
+            }
+            break;
+        case FLAGS_SUBI:
+            if(imediato >= 0) {
+                ov = _mm256_srai_epi32(_mm256_andnot_si256(rz, rx), 31);
+            } else {
+                soma = _mm256_sub_epi32(rx, _mm256_set1_epi32(imediato));
+                ov = _mm256_srai_epi32(_mm256_xor_si256(rz, rx), 31);
+                cy = _mm256_cmpgt_epi32(_mm256_xor_si256(rx, sinal), _mm256_xor_si256(soma, sinal));
+            }
+            break;
+        case FLAGS_CMPI:
+            diferenca = _mm256_sub_epi32(rx, _mm256_set1_epi32(imediato));
+            zn = _mm256_cmpeq_epi32(diferenca, zero);
+            sn = _mm256_srai_epi32(diferenca, 31);
+            ov = _mm256_srai_epi32(imediato >= 0 ? _mm256_andnot_si256(diferenca, rx) : _mm256_xor_si256(diferenca, rx), 31);
+            cy = sn;
+            break;
+        case FLAGS_DESLOCAMENTO:
+        case FLAGS_DESLOCAMENTO_ARITMETICO:
+            // Resultado de 64 bits em R[z]:R[x]; a flag indica os 32 bits superiores não nulos
+            zn = _mm256_and_si256(zn, _mm256_cmpeq_epi32(rx, zero));
+            cy = _mm256_xor_si256(_mm256_cmpeq_epi32(rz, zero), _mm256_set1_epi32(-1));
+            ov = cy;
+            break;
+        default:
+            break;
+    }
+
+    __m256i flags = _mm256_and_si256(zn, _mm256_set1_epi32(0b1 << ZN));
+    flags = _mm256_or_si256(flags, _mm256_and_si256(sn, _mm256_set1_epi32(0b1 << SN)));
+    flags = _mm256_or_si256(flags, _mm256_and_si256(ov, _mm256_set1_epi32(0b1 << OV)));
+    flags = _mm256_or_si256(flags, _mm256_and_si256(cy, _mm256_set1_epi32(0b1 << CY)));
+
+    // Apenas as flags que a operação escreve
+    return _mm256_and_si256(flags, _mm256_set1_epi32(FLAGS_AFETADAS[operacao]));
+}
+
+__attribute__((target("avx2")))
+void deslocar_vetorial(GrupoVetorial *grupo, InstrucaoDecodificada *instrucao, __m256i pistas)
+{
+    // R[z]:R[y] como 64 bits em dois vetores (pistas 0, 1, 4 e 5 e pistas 2, 3, 6 e 7), deslocados juntos.
+    // sll e sla têm os mesmos bits: a multiplicação por 2^(l+1) com sinal só difere na interpretação
+    __m256i rz = _mm256_load_si256((__m256i *)grupo->R[instrucao->z]);
+    __m256i ry = _mm256_load_si256((__m256i *)grupo->R[instrucao->y]);
+    __m128i quantidade = _mm_cvtsi32_si128(instrucao->l + 1);
+    __m256i pares[2] = {_mm256_unpacklo_epi32(ry, rz), _mm256_unpackhi_epi32(ry, rz)};
+
+    for(int i = 0; i < 2; i++)
+        pares[i] = instrucao->operacao == OP_SRL ? _mm256_srl_epi64(pares[i], quantidade) : _mm256_sll_epi64(pares[i], quantidade);
+
+    __m256i baixo = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(pares[0]), _mm256_castsi256_ps(pares[1]), _MM_SHUFFLE(2, 0, 2, 0)));
+    __m256i alto = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(pares[0]), _mm256_castsi256_ps(pares[1]), _MM_SHUFFLE(3, 1, 3, 1)));
+
+    // R[z] antes de R[x], como no tratador; R[0] não pode armazenar um valor diferente de 0
+    if(instrucao->z)
+        _mm256_store_si256((__m256i *)grupo->R[instrucao->z], _mm256_blendv_epi8(rz, alto, pistas));
+
+    if(instrucao->x) {
+        __m256i rx = _mm256_load_si256((__m256i *)grupo->R[instrucao->x]);
+        _mm256_store_si256((__m256i *)grupo->R[instrucao->x], _mm256_blendv_epi8(rx, baixo, pistas));
+    }
+}
+
+uint32_t acessar_memoria_vetorial(GrupoVetorial *grupo, InstrucaoDecodificada *instrucao, uint32_t mascara)
+{
+    uint32_t escalares = 0;
+    int16_t i = instrucao->imediato;
+
+    for(; mascara; mascara &= mascara - 1) {
+        int pista = __builtin_ctz(mascara);
+        Poxim *maquina = grupo->maquinas[pista];
+        uint32_t endereco = (grupo->R[instrucao->x][pista] + i) << 2, indice = endereco >> 2;
+
+        // Endereços na janela do barramento de dispositivos ficam com o tratador
+        if(endereco - maquina->inicioBarramento <= maquina->extensaoBarramento) {
+            escalares |= 0b1 << pista;
+            continue;
+        }
+
+        if(instrucao->operacao == OP_S32) {
+            maquina->MEM[indice] = grupo->R[instrucao->z][pista];
+            invalidar_instrucao_decodificada(maquina, indice);
+            grupo->geracao++;
+        } else if(instrucao->z) {
+            grupo->R[instrucao->z][pista] = maquina->MEM[indice];
+        }
+    }
+
+    return escalares;
+}
+
+uint8_t instrucao_vetorial(InstrucaoDecodificada *decodificada)
+{
+    // Com o SR como operando, as flags são lidas ou escritas diretamente e interrupções podem ser liberadas;
+    // PC e IR como operandos dependem do que o tratador mantém na máquina
+    uint8_t especial = decodificada->z == PC || decodificada->z == IR;
+    uint8_t especialXY = decodificada->x == PC || decodificada->x == IR || decodificada->y == PC || decodificada->y == IR;
+
+    if(decodificada->usaSR)
+        return 0;
+
+    switch(decodificada->operacao) {
+        case OP_MOV:
+        case OP_MOVS:
+            return !especial;
+        case OP_ADD:
+        case OP_SUB:
+        case OP_AND:
+        case OP_OR:
+        case OP_XOR:
+        case OP_NOT:
+        case OP_ADDI:
+        case OP_SUBI:
+        case OP_CMP:
+        case OP_CMPI:
+        case OP_SLL:
+        case OP_SRL:
+        case OP_SLA:
+        case OP_SRA:
+        case OP_L32:
+        case OP_S32:
+            return !especial && !especialXY;
+        case OP_BAE:
+        case OP_BAT:
+        case OP_BBE:
+        case OP_BBT:
+        case OP_BEQ:
+        case OP_BGE:
+        case OP_BGT:
+        case OP_BIV:
+        case OP_BLE:
+        case OP_BLT:
+        case OP_BNE:
+        case OP_BNI:
+        case OP_BNZ:
+        case OP_BUN:
+        case OP_BZD:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+__attribute__((target("avx2")))
+__m256i desvios_tomados(Operacao operacao, __m256i sr)
+{
+    // As condições dos tratadores dos desvios em todas as pistas, com cada flag do SR como máscara (-1 ou 0)
+    const __m256i todos = _mm256_set1_epi32(-1);
+    __m256i cy = _mm256_srai_epi32(_mm256_slli_epi32(sr, 31 - CY), 31);
+    __m256i iv = _mm256_srai_epi32(_mm256_slli_epi32(sr, 31 - IV), 31);
+    __m256i zd = _mm256_srai_epi32(_mm256_slli_epi32(sr, 31 - ZD), 31);
+    __m256i zn = _mm256_srai_epi32(_mm256_slli_epi32(sr, 31 - ZN), 31);
+
+    // SN diferente de OV
+    __m256i menor = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_xor_si256(sr, _mm256_srli_epi32(sr, SN - OV)), 31 - OV), 31);
+
+    switch(operacao) {
+        case OP_BAE:
+            return _mm256_xor_si256(cy, todos);
+        case OP_BAT:
+            return _mm256_xor_si256(_mm256_or_si256(zn, cy), todos);
+        case OP_BBE:
+            return _mm256_or_si256(zn, cy);
+        case OP_BBT:
+            return cy;
+        case OP_BEQ:
+            return zn;
+        case OP_BGE:
+            return _mm256_xor_si256(menor, todos);
+        case OP_BGT:
+            return _mm256_xor_si256(_mm256_or_si256(zn, menor), todos);
+        case OP_BIV:
+            return iv;
+        case OP_BLE:
+            return _mm256_or_si256(zn, menor);
+        case OP_BLT:
+            return menor;
+        case OP_BNE:
+            return _mm256_xor_si256(zn, todos);
+        case OP_BNI:
+            return _mm256_xor_si256(iv, todos);
+        case OP_BNZ:
+            return _mm256_xor_si256(zd, todos);
+        case OP_BZD:
+            return zd;
+        default:
+            return todos;
+    }
+}
+
+void carregar_pista(GrupoVetorial *grupo, int pista)
+{
+    Poxim *maquina = grupo->maquinas[pista];
+
+    // O motor vetorial trabalha com o SR calculado
+    materializar_flags(maquina);
+
+    for(int r = 0; r < 32; r++)
+        grupo->R[r][pista] = maquina->R[r];
+
+    // A instrução do próximo evento agendado é executada pelo tratador, que o processa em concluir_instrucao
+    uint64_t folga = maquina->proximoEvento > maquina->instrucoesExecutadas + 1 ?
+        maquina->proximoEvento - maquina->instrucoesExecutadas - 1 : 0;
+
+    grupo->folga[pista] = folga < 0x7FFFFFFF ? folga : 0x7FFFFFFF;
+    grupo->executadas[pista] = 0;
+
+    if(!maquina->emExecucao)
+        grupo->ativas &= ~(0b1 << pista);
+}
+
+void descarregar_pista(GrupoVetorial *grupo, int pista)
+{
+    Poxim *maquina = grupo->maquinas[pista];
+
+    for(int r = 0; r < 32; r++)
+        maquina->R[r] = grupo->R[r][pista];
+
+    maquina->instrucoesExecutadas += grupo->executadas[pista];
+    grupo->executadas[pista] = 0;
+}
+
+void executar_pista_escalar(GrupoVetorial *grupo, int pista)
+{
+    Poxim *maquina = grupo->maquinas[pista];
+
+    descarregar_pista(grupo, pista);
+    grupo->geracao++;
+
+    // Uma volta do laço principal na máquina da pista
+    InstrucaoDecodificada *instrucaoAtual = buscar_instrucao(maquina, maquina->R[PC]);
+
+    executar_instrucao(maquina, instrucaoAtual);
+    concluir_instrucao(maquina);
+
+    carregar_pista(grupo, pista);
+}
+#endif
+
+#ifdef CACHE_RESULTADOS
+// Cache de resultados: a simulação é determinística para a mesma imagem e o mesmo modo de trace, então a saída
+// de uma simulação concluída é guardada em <diretório>/resultado-<resumo>.out e copiada nas execuções seguintes.
+// O resumo é um SHA-256: um resultado encontrado é o da mesma imagem, sem colisões acidentais ou construídas.
+// O tempo de modificação de cada resultado marca o seu último uso; acima do limite, os usados há mais tempo
+// são descartados
+
+uint8_t restaurar_resultado(Poxim *maquina, const uint32_t *imagem, uint32_t quantidade, const char *saida)
+{
+    char caminho[4096];
+
+    if(!maquina->diretorioResultados || maquina->cacheIgnorada)
+        return 0;
+
+    // Resumo da compilação do simulador, do modo de trace, do tamanho e das palavras da imagem
+    uint32_t cabecalho[3] = {maquina->modoTrace, maquina->traceBinario, quantidade};
+
+    if(!resumir_imagem(cabecalho, 3, imagem, quantidade, maquina->resumoResultado))
+        return 0;
+
+    snprintf(caminho, sizeof(caminho), "%s/resultado-%s.out", maquina->diretorioResultados, maquina->resumoResultado);
+
+    if(copiar_arquivo(caminho, saida)) {
+        // Último uso do resultado
+        utimensat(AT_FDCWD, caminho, NULL, 0);
+        return 1;
+    }
+
+    // Ausente da cache: guardado ao fim da simulação
+    maquina->caminhoResultado = saida;
+
+    return 0;
+}
+
+void guardar_resultado(Poxim *maquina)
+{
+    char caminho[4096], temporario[4096];
+
+    // Copiado para um arquivo próprio desta máquina e renomeado ao fim, como as traduções antecipadas
+    snprintf(caminho, sizeof(caminho), "%s/resultado-%s.out", maquina->diretorioResultados, maquina->resumoResultado);
+    snprintf(temporario, sizeof(temporario), "%s/resultado-%s.%d-%lx.tmp", maquina->diretorioResultados,
+        maquina->resumoResultado, getpid(), (unsigned long)(uintptr_t)maquina);
+
+    if(!copiar_arquivo(maquina->caminhoResultado, temporario) || rename(temporario, caminho)) {
+        fprintf(stderr, "Não foi possível guardar o resultado: %s\n", caminho);
+        unlink(temporario);
+        return;
+    }
+
+    descartar_resultados(maquina);
+}
+
+void descartar_resultados(Poxim *maquina)
+{
+    DIR *diretorio = opendir(maquina->diretorioResultados);
+
+    if(!diretorio)
+        return;
+
+    ResultadoEmCache *resultados = NULL;
+    uint32_t quantidade = 0, capacidade = 0;
+    uint64_t total = 0;
+    struct dirent *entrada;
+    struct stat informacoes;
+
+    while((entrada = readdir(diretorio))) {
+        size_t tamanhoNome = strlen(entrada->d_name);
+
+        // Apenas os resultados guardados (resultado-<resumo>.out), sem os temporários e os demais arquivos
+        if(tamanhoNome != strlen("resultado-") + 64 + strlen(".out") || strncmp(entrada->d_name, "resultado-", 10) ||
+            strcmp(entrada->d_name + tamanhoNome - 4, ".out") || fstatat(dirfd(diretorio), entrada->d_name, &informacoes, 0))
+            continue;
+
+        if(quantidade == capacidade) {
+            capacidade = capacidade ? 2 * capacidade : 64;
+            resultados = (ResultadoEmCache *)realloc(resultados, capacidade * sizeof(ResultadoEmCache));
+        }
+
+        strcpy(resultados[quantidade].nome, entrada->d_name);
+        resultados[quantidade].tamanho = informacoes.st_size;
+        resultados[quantidade].usado = informacoes.st_mtim;
+        total += informacoes.st_size;
+        quantidade++;
+    }
+
+    // Os usados há mais tempo primeiro, até o total caber no limite. Outro processo pode ter descartado o
+    // mesmo resultado ao mesmo tempo, então a remoção não é verificada
+    if(total > maquina->limiteResultados) {
+        qsort(resultados, quantidade, sizeof(ResultadoEmCache), comparar_resultados);
+
+        for(uint32_t i = 0; i < quantidade && total > maquina->limiteResultados; i++) {
+            unlinkat(dirfd(diretorio), resultados[i].nome, 0);
+            total -= resultados[i].tamanho;
+        }
+    }
+
+    closedir(diretorio);
+    free(resultados);
+}
+
+int comparar_resultados(const void *a, const void *b)
+{
+    const struct timespec *x = &((const ResultadoEmCache *)a)->usado, *y = &((const ResultadoEmCache *)b)->usado;
+
+    // Ordem crescente do último uso
+    if(x->tv_sec != y->tv_sec)
+        return x->tv_sec < y->tv_sec ? -1 : 1;
+
+    return x->tv_nsec < y->tv_nsec ? -1 : x->tv_nsec > y->tv_nsec ? 1 : 0;
+}
+
+uint8_t copiar_arquivo(const char *origem, const char *destino)
+{
+    struct stat informacoes;
+    int entrada = open(origem, O_RDONLY), saida;
+
+    if(entrada < 0)
+        return 0;
+
+    if(fstat(entrada, &informacoes) || (saida = open(destino, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0) {
+        close(entrada);
+        return 0;
+    }
+
+    // Os blocos do arquivo são compartilhados (reflink) quando o sistema de arquivos permite
+    uint8_t copiado = !ioctl(saida, FICLONE, entrada);
+
+    if(!copiado) {
+        off_t restante = informacoes.st_size;
+        ssize_t copiados;
+        char bloco[65536];
+
+        // Cópia feita pelo kernel, sem passar pelo processo
+        while(restante > 0 && (copiados = copy_file_range(entrada, NULL, saida, NULL, restante, 0)) > 0)
+            restante -= copiados;
+
+        // Sem a cópia pelo kernel (entre sistemas de arquivos, por exemplo): leitura e escrita do restante
+        while(restante > 0 && (copiados = read(entrada, bloco, sizeof(bloco))) > 0 && write(saida, bloco, copiados) == copiados)
+            restante -= copiados;
+
+        copiado = !restante;
+    }
+
+    close(entrada);
+
+    return !close(saida) && copiado;
+}
+#endif
+
+#if defined(CACHE_RESULTADOS) || defined(TRADUCAO_ANTECIPADA)
+uint8_t resumir_imagem(const uint32_t *cabecalho, uint32_t campos, const uint32_t *imagem, uint32_t quantidade, char *resumo)
+{
+    // SHA-256 da identificação do simulador, do cabeçalho e das palavras da imagem, em 64 dígitos hexadecimais.
+    // Sem a identificação, nenhum arquivo de outra execução pode ser reaproveitado com segurança
+    uint8_t bytes[32];
+    Sha256 sha256;
+
+    pthread_once(&identificacaoCalculada, calcular_identificacao_simulador);
+
+    if(!simuladorIdentificado)
+        return 0;
+
+    iniciar_sha256(&sha256);
+    atualizar_sha256(&sha256, identificacaoSimulador, sizeof(identificacaoSimulador));
+    atualizar_sha256(&sha256, cabecalho, campos * sizeof(uint32_t));
+    atualizar_sha256(&sha256, imagem, (size_t)quantidade * sizeof(uint32_t));
+    concluir_sha256(&sha256, bytes);
+
+    for(int i = 0; i < 32; i++)
+        sprintf(&resumo[2 * i], "%02x", bytes[i]);
+
+    return 1;
+}
+
+void calcular_identificacao_simulador()
+{
+    // Arquivo com o código do simulador; um executável chamado pelo PATH é lido de /proc/self/exe
+    Dl_info informacoes;
+    int arquivo = -1;
+
+    if(dladdr((void *)calcular_identificacao_simulador, &informacoes) && informacoes.dli_fname)
+        arquivo = open(informacoes.dli_fname, O_RDONLY);
+    if(arquivo < 0)
+        arquivo = open("/proc/self/exe", O_RDONLY);
+    if(arquivo < 0)
+        return;
+
+    Sha256 sha256;
+    char bloco[65536];
+    ssize_t lidos;
+
+    iniciar_sha256(&sha256);
+
+    while((lidos = read(arquivo, bloco, sizeof(bloco))) > 0)
+        atualizar_sha256(&sha256, bloco, lidos);
+
+    close(arquivo);
+
+    if(lidos < 0)
+        return;
+
+    concluir_sha256(&sha256, identificacaoSimulador);
+    simuladorIdentificado = 1;
+}
+
+void iniciar_sha256(Sha256 *sha256)
+{
+    memcpy(sha256->estado, ESTADO_INICIAL_SHA256, sizeof(sha256->estado));
+    sha256->tamanho = 0;
+}
+
+void atualizar_sha256(Sha256 *sha256, const void *dados, size_t tamanho)
+{
+    const uint8_t *bytes = (const uint8_t *)dados;
+
+    // Completa o bloco pendente e processa os blocos inteiros; o restante fica pendente
+    while(tamanho) {
+        uint32_t pendentes = sha256->tamanho % 64, copiados = 64 - pendentes < tamanho ? 64 - pendentes : tamanho;
+
+        if(!pendentes && tamanho >= 64) {
+            processar_bloco_sha256(sha256, bytes);
+            copiados = 64;
+        } else {
+            memcpy(&sha256->bloco[pendentes], bytes, copiados);
+
+            if(pendentes + copiados == 64)
+                processar_bloco_sha256(sha256, sha256->bloco);
+        }
+
+        sha256->tamanho += copiados;
+        bytes += copiados;
+        tamanho -= copiados;
+    }
+}
+
+void concluir_sha256(Sha256 *sha256, uint8_t *resumo)
+{
+    // Preenchimento: o bit 1, zeros até 56 bytes no último bloco e o tamanho em bits, big-endian
+    uint64_t bits = sha256->tamanho * 8;
+    uint8_t preenchimento[72] = {0x80};
+    uint32_t tamanhoPreenchimento = (sha256->tamanho % 64 < 56 ? 56 : 120) - sha256->tamanho % 64;
+
+    for(int i = 0; i < 8; i++)
+        preenchimento[tamanhoPreenchimento + i] = bits >> (56 - 8 * i);
+
+    atualizar_sha256(sha256, preenchimento, tamanhoPreenchimento + 8);
+
+    for(int i = 0; i < 32; i++)
+        resumo[i] = sha256->estado[i / 4] >> (24 - 8 * (i % 4));
+}
+
+void processar_bloco_sha256(Sha256 *sha256, const uint8_t *bloco)
+{
+    uint32_t w[64], v[8];
+
+    // Palavras do bloco (big-endian) e a sua expansão
+    for(int i = 0; i < 16; i++)
+        w[i] = ((uint32_t)bloco[4 * i] << 24) | ((uint32_t)bloco[4 * i + 1] << 16) | ((uint32_t)bloco[4 * i + 2] << 8) | bloco[4 * i + 3];
+
+    for(int i = 16; i < 64; i++) {
+        uint32_t s0 = ((w[i - 15] >> 7) | (w[i - 15] << 25)) ^ ((w[i - 15] >> 18) | (w[i - 15] << 14)) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ((w[i - 2] >> 17) | (w[i - 2] << 15)) ^ ((w[i - 2] >> 19) | (w[i - 2] << 13)) ^ (w[i - 2] >> 10);
+
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    memcpy(v, sha256->estado, sizeof(v));
+
+    // 64 rodadas sobre as variáveis de trabalho a..h (v[0] a v[7])
+    for(int i = 0; i < 64; i++) {
+        uint32_t s1 = ((v[4] >> 6) | (v[4] << 26)) ^ ((v[4] >> 11) | (v[4] << 21)) ^ ((v[4] >> 25) | (v[4] << 7));
+        uint32_t escolha = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        uint32_t t1 = v[7] + s1 + escolha + RODADAS_SHA256[i] + w[i];
+        uint32_t s0 = ((v[0] >> 2) | (v[0] << 30)) ^ ((v[0] >> 13) | (v[0] << 19)) ^ ((v[0] >> 22) | (v[0] << 10));
+        uint32_t maioria = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+
+        memmove(&v[1], &v[0], 7 * sizeof(uint32_t));
+        v[4] += t1;
+        v[0] = t1 + s0 + maioria;
+    }
+
+    for(int i = 0; i < 8; i++)
+        sha256->estado[i] += v[i];
+}
+#endif
+
+#ifdef SERVIDOR
+int executar_servidor(int argc, char *argv[])
+{
+    Servidor servidor = {0};
+    struct sockaddr_un endereco = {0};
+    long totalTrabalhadores;
+
+    if(argc < 3) {
+        fprintf(stderr, "Uso: %s --serve <soquete> [--threads=N] [opções]\n", argv[0]);
+        return 1;
+    }
+
+    servidor.argv = separar_opcoes_paralelas(argc, argv, &servidor.argc, &totalTrabalhadores);
+
+    if(!servidor.argv)
+        return 1;
+
+    if(strlen(argv[2]) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Caminho do soquete muito longo: %s\n", argv[2]);
+        free(servidor.argv);
+        return 1;
+    }
+
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, argv[2]);
+
+    // Um soquete deixado por uma execução anterior é substituído
+    unlink(argv[2]);
+
+    servidor.soquete = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(servidor.soquete < 0 || bind(servidor.soquete, (struct sockaddr *)&endereco, sizeof(endereco)) ||
+        listen(servidor.soquete, 64)) {
+        fprintf(stderr, "Não foi possível abrir o soquete: %s\n", argv[2]);
+
+        if(servidor.soquete >= 0)
+            close(servidor.soquete);
+
+        free(servidor.argv);
+        return 1;
+    }
+
+    pthread_mutex_init(&servidor.trava, NULL);
+    servidor.emEspera = (MaquinaEmEspera *)calloc(MAQUINAS_EM_ESPERA, sizeof(MaquinaEmEspera));
+
+    // A thread principal é um dos trabalhadores; o servidor atende conexões até ser encerrado
+    pthread_t *threads = (pthread_t *)malloc(totalTrabalhadores * sizeof(pthread_t));
+
+    for(long i = 1; i < totalTrabalhadores; i++)
+        pthread_create(&threads[i], NULL, executar_trabalhador_servidor, &servidor);
+
+    executar_trabalhador_servidor(&servidor);
+
+    for(long i = 1; i < totalTrabalhadores; i++)
+        pthread_join(threads[i], NULL);
+
+    for(int i = 0; i < servidor.totalEmEspera; i++) {
+        liberar_simulador(servidor.emEspera[i].maquina);
+        free(servidor.emEspera[i].imagem);
+    }
+
+    close(servidor.soquete);
+    unlink(argv[2]);
+
+    pthread_mutex_destroy(&servidor.trava);
+
+    free(threads);
+    free(servidor.emEspera);
+    free(servidor.argv);
+
+    return 0;
+}
+
+void *executar_trabalhador_servidor(void *argumento)
+{
+    Servidor *servidor = (Servidor *)argumento;
+    ConexaoServidor conexao;
+
+    conexao.terminal = (char *)malloc(TAMANHO_TERMINAL_SERVIDOR * sizeof(char));
+
+    // Cada trabalhador aceita as conexões diretamente do soquete e atende uma por vez
+    while(1) {
+        conexao.descritor = accept(servidor->soquete, NULL, NULL);
+
+        if(conexao.descritor < 0) {
+            if(errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            break;
+        }
+
+        conexao.perdida = 0;
+        atender_conexao(servidor, &conexao);
+
+        close(conexao.descritor);
+    }
+
+    free(conexao.terminal);
+
+    return NULL;
+}
+
+void atender_conexao(Servidor *servidor, ConexaoServidor *conexao)
+{
+    // Pedidos em sequência até a conexão ser fechada ou um pedido ser inválido
+    while(atender_pedido(servidor, conexao));
+}
+
+uint8_t atender_pedido(Servidor *servidor, ConexaoServidor *conexao)
+{
+    PedidoServidor pedido;
+
+    if(!receber_servidor(conexao, &pedido, sizeof(PedidoServidor)))
+        return 0;
+
+    if(memcmp(pedido.assinatura, ASSINATURA_PEDIDO_SERVIDOR, sizeof(pedido.assinatura)) ||
+        pedido.modoTrace > POXIM_TRACE_BINARY || pedido.quantidade > PALAVRAS_MEMORIA) {
+        const char *erro = "Pedido inválido";
+
+        enviar_mensagem(conexao, MENSAGEM_ERRO, erro, strlen(erro));
+        return 0;
+    }
+
+    uint32_t *imagem = (uint32_t *)malloc((pedido.quantidade + 1) * sizeof(uint32_t));
+
+    if(!imagem) {
+        const char *erro = "Imagem grande demais";
+
+        enviar_mensagem(conexao, MENSAGEM_ERRO, erro, strlen(erro));
+        return 0;
+    }
+
+    if(!receber_servidor(conexao, imagem, pedido.quantidade * sizeof(uint32_t))) {
+        free(imagem);
+        return 0;
+    }
+
+    uint64_t resumo = resumir_palavras(RESUMO_INICIAL, imagem, pedido.quantidade);
+    uint8_t reaproveitada;
+    Poxim *maquina = obter_maquina_servidor(servidor, imagem, pedido.quantidade, resumo, pedido.modoTrace, &reaproveitada);
+
+    // O trace é escrito diretamente na conexão, e o terminal é acumulado e enviado a cada fatia da execução
+    cookie_io_functions_t funcoes = {NULL, escrever_trace_servidor, NULL, NULL};
+
+    maquina->saida = fopencookie(conexao, "w", funcoes);
+    poxim_set_device(maquina, POXIM_DEVICE_TERMINAL, NULL, escrever_terminal_servidor, conexao);
+    conexao->tamanhoTerminal = 0;
+
+    if(reaproveitada)
+        reiniciar_simulador(maquina, imagem, pedido.quantidade);
+    else
+        poxim_load_image(maquina, imagem, pedido.quantidade);
+
+    uint64_t restante = pedido.limite ? pedido.limite : POXIM_SEM_LIMITE;
+
+    while(poxim_running(maquina) && restante && !conexao->perdida) {
+        uint64_t executadas = poxim_run(maquina, restante < FATIA_SERVIDOR ? restante : FATIA_SERVIDOR);
+
+        if(restante != POXIM_SEM_LIMITE)
+            restante -= executadas;
+
+        enviar_terminal_servidor(conexao);
+    }
+
+    FimServidor fim = {poxim_instructions(maquina), !poxim_running(maquina), reaproveitada};
+
+    // Terminal, resumo e fim da simulação no trace; fechar a saída envia o restante
+    encerrar_execucao(maquina);
+
+    devolver_maquina_servidor(servidor, maquina, imagem, pedido.quantidade, resumo, pedido.modoTrace);
+    free(imagem);
+
+    return enviar_mensagem(conexao, MENSAGEM_FIM, &fim, sizeof(FimServidor));
+}
+
+Poxim *obter_maquina_servidor(Servidor *servidor, const uint32_t *imagem, uint32_t quantidade, uint64_t resumo, PoximTrace modo, uint8_t *reaproveitada)
+{
+    Poxim *maquina = NULL;
+
+    // A máquina em espera mais recente com a mesma imagem e o mesmo modo de trace (o JIT só compila sem o
+    // trace completo, então os blocos compilados não servem a outro modo)
+    pthread_mutex_lock(&servidor->trava);
+    for(int i = servidor->totalEmEspera - 1; i >= 0; i--) {
+        MaquinaEmEspera *candidata = &servidor->emEspera[i];
+
+        if(candidata->resumo != resumo || candidata->quantidade != quantidade || candidata->modo != modo ||
+            memcmp(candidata->imagem, imagem, quantidade * sizeof(uint32_t)))
+            continue;
+
+        maquina = candidata->maquina;
+        free(candidata->imagem);
+
+        memmove(candidata, candidata + 1, (servidor->totalEmEspera - 1 - i) * sizeof(MaquinaEmEspera));
+        servidor->totalEmEspera--;
+        break;
+    }
+    pthread_mutex_unlock(&servidor->trava);
+
+    *reaproveitada = maquina != NULL;
+
+    if(maquina)
+        return maquina;
+
+    // Máquina nova, com as opções da linha de comando e o modo de trace do pedido
+    maquina = poxim_create();
+    interpretar_opcoes(maquina, servidor->argc, servidor->argv);
+    poxim_set_trace(maquina, modo);
+
+    return maquina;
+}
+
+void devolver_maquina_servidor(Servidor *servidor, Poxim *maquina, const uint32_t *imagem, uint32_t quantidade, uint64_t resumo, PoximTrace modo)
+{
+    MaquinaEmEspera entrada = {maquina, (uint32_t *)malloc((quantidade + 1) * sizeof(uint32_t)), quantidade, resumo, modo};
+    MaquinaEmEspera descartada = {0};
+
+    memcpy(entrada.imagem, imagem, quantidade * sizeof(uint32_t));
+
+    // Com todas as posições ocupadas, a máquina em espera há mais tempo é descartada
+    pthread_mutex_lock(&servidor->trava);
+    if(servidor->totalEmEspera == MAQUINAS_EM_ESPERA) {
+        descartada = servidor->emEspera[0];
+
+        memmove(servidor->emEspera, servidor->emEspera + 1, (MAQUINAS_EM_ESPERA - 1) * sizeof(MaquinaEmEspera));
+        servidor->totalEmEspera--;
+    }
+
+    servidor->emEspera[servidor->totalEmEspera++] = entrada;
+    pthread_mutex_unlock(&servidor->trava);
+
+    if(descartada.maquina) {
+        liberar_simulador(descartada.maquina);
+        free(descartada.imagem);
+    }
+}
+
+void reiniciar_simulador(Poxim *maquina, const uint32_t *imagem, uint32_t tamanhoImagem)
+{
+    // Estado inicial da execução, como em criar_maquina. As instruções decodificadas, os blocos traduzidos
+    // e o código nativo são mantidos
+    memset(maquina->R, 0, sizeof(maquina->R));
+    maquina->flagsPendentes.operacao = FLAGS_MATERIALIZADAS;
+    maquina->emExecucao = 1;
+    maquina->pausada = 0;
+    maquina->pcAtual = 0;
+    maquina->instrucoesExecutadas = 0;
+
+    memset(maquina->tabelaInterrupcoes, 0, sizeof(maquina->tabelaInterrupcoes));
+    maquina->interrupcoesAgendadas = 0;
+    maquina->watchdog = 0;
+
+    maquina->fpuX.u = 0;
+    maquina->fpuY.u = 0;
+    maquina->fpuZ.u = 0;
+    maquina->fpuX_IEEE754 = 0;
+    maquina->fpuY_IEEE754 = 0;
+    maquina->fpuZ_IEEE754 = 1;
+    maquina->fpuControle = 0;
+    maquina->fpuContador = -1;
+    maquina->fpuPrioridade = 0;
+
+    maquina->tamanhoOutput = 0;
+    maquina->totalInstrucoesInvalidas = 0;
+    maquina->totalInterrupcoesSoftware = 0;
+    memset(maquina->totalInterrupcoesHardware, 0, sizeof(maquina->totalInterrupcoesHardware));
+    maquina->tamanhoTrace = 0;
+
+    // A memória volta à imagem. Na imagem e no início da memória, coberto pelas tabelas de blocos, só as palavras
+    // alteradas pela execução anterior são descartadas das caches, como em uma escrita durante a execução
+    uint32_t palavrasPagina = sysconf(_SC_PAGESIZE) / sizeof(uint32_t);
+    uint32_t comparadas = tamanhoImagem > 32 * 1024 / 4 ? tamanhoImagem : 32 * 1024 / 4;
+
+    comparadas = (comparadas + palavrasPagina - 1) / palavrasPagina * palavrasPagina;
+
+    for(uint32_t i = 0; i < comparadas; i++) {
+        uint32_t palavra = i < tamanhoImagem ? imagem[i] : 0;
+
+        if(maquina->MEM[i] != palavra) {
+            maquina->MEM[i] = palavra;
+            invalidar_instrucao_decodificada(maquina, i);
+        }
+    }
+
+    // O restante volta ao sistema, e as páginas tocadas voltam a ser lidas como 0. As páginas de instruções
+    // decodificadas além das palavras comparadas são descartadas
+    madvise(maquina->MEM + comparadas, ((size_t)PALAVRAS_MEMORIA - comparadas) * sizeof(uint32_t), MADV_DONTNEED);
+    descartar_paginas_instrucoes(maquina, (comparadas + (1u << BITS_PAGINA_INSTRUCOES) - 1) >> BITS_PAGINA_INSTRUCOES);
+
+    iniciar_execucao(maquina);
+}
+
+uint8_t receber_servidor(ConexaoServidor *conexao, void *destino, size_t tamanho)
+{
+    for(size_t recebido = 0; recebido < tamanho;) {
+        ssize_t resultado = recv(conexao->descritor, (char *)destino + recebido, tamanho - recebido, 0);
+
+        if(resultado < 0 && errno == EINTR)
+            continue;
+
+        // Conexão fechada ou com erro
+        if(resultado <= 0)
+            return 0;
+
+        recebido += resultado;
+    }
+
+    return 1;
+}
+
+uint8_t enviar_mensagem(ConexaoServidor *conexao, TipoMensagem tipo, const void *dados, uint32_t tamanho)
+{
+    MensagemServidor cabecalho = {tipo, tamanho};
+    const char *partes[2] = {(const char *)&cabecalho, (const char *)dados};
+    size_t tamanhos[2] = {sizeof(MensagemServidor), tamanho};
+
+    // Cliente desconectado: o restante do pedido é executado sem enviar nada
+    for(int parte = 0; parte < 2 && !conexao->perdida; parte++) {
+        for(size_t enviado = 0; enviado < tamanhos[parte];) {
+            ssize_t resultado = send(conexao->descritor, partes[parte] + enviado, tamanhos[parte] - enviado, MSG_NOSIGNAL);
+
+            if(resultado < 0 && errno == EINTR)
+                continue;
+
+            if(resultado <= 0) {
+                conexao->perdida = 1;
+                break;
+            }
+
+            enviado += resultado;
+        }
+    }
+
+    return !conexao->perdida;
+}
+
+void enviar_terminal_servidor(ConexaoServidor *conexao)
+{
+    if(conexao->tamanhoTerminal)
+        enviar_mensagem(conexao, MENSAGEM_TERMINAL, conexao->terminal, conexao->tamanhoTerminal);
+
+    conexao->tamanhoTerminal = 0;
+}
+
+int escrever_terminal_servidor(void *contexto, uint32_t endereco, uint32_t valor)
+{
+    ConexaoServidor *conexao = (ConexaoServidor *)contexto;
+
+    // O terminal tem um único endereço de escrita
+    (void)endereco;
+
+    if(conexao->tamanhoTerminal == TAMANHO_TERMINAL_SERVIDOR)
+        enviar_terminal_servidor(conexao);
+
+    conexao->terminal[conexao->tamanhoTerminal++] = (char)valor;
+
+    // O terminal do simulador também registra o caractere, escrito no fim do trace
+    return 0;
+}
+
+ssize_t escrever_trace_servidor(void *contexto, const char *dados, size_t tamanho)
+{
+    if(!enviar_mensagem((ConexaoServidor *)contexto, MENSAGEM_TRACE, dados, tamanho))
+        return -1;
+
+    return tamanho;
+}
+#endif
+
+Poxim *criar_maquina()
+{
+    // Estado zerado, exceto os valores iniciais diferentes de 0
+    Poxim *maquina = (Poxim *)calloc(1, sizeof(Poxim));
+
+    maquina->emExecucao = 1;
+    maquina->modoTrace = TRACE_COMPLETO;
+    maquina->flagsPendentes.operacao = FLAGS_MATERIALIZADAS;
+    maquina->fpuZ_IEEE754 = 1;
+    maquina->fpuContador = -1;
+
+#ifdef BLOCOS_BASICOS
+    maquina->geracaoBlocos = 1;
+#endif
+
+    // Dispositivos mapeados em memória: o terminal, o watchdog e o FPU
+    registrar_regiao(maquina, 0x8888888A, 0x8888888B, ler_terminal, escrever_terminal);
+    registrar_regiao(maquina, 0x80808080, 0x80808083, ler_watchdog, escrever_watchdog);
+    registrar_regiao(maquina, 0x80808880, 0x8080888F, ler_fpu, escrever_fpu);
+
+#ifdef CACHE_RESULTADOS
+    maquina->limiteResultados = LIMITE_PADRAO_RESULTADOS * 1024 * 1024;
+#endif
+
+    return maquina;
+}
+
+uint8_t inicializar_simulador(Poxim *maquina, const uint32_t *imagem, uint32_t tamanhoImagem)
+{
+    // 4GiB de memória inicializados com 0. Só as páginas tocadas pela execução ocupam memória
+    maquina->MEM = (uint32_t *)reservar_memoria((size_t)PALAVRAS_MEMORIA * sizeof(uint32_t));
+
+    if(!maquina->MEM) {
+        fprintf(stderr, "Não foi possível reservar a memória do simulador\n");
+        return 0;
+    }
+
+    // Cache de pré-decodificação com as entradas do início da memória, inicialmente inválidas, e a tabela de
+    // páginas, que aponta para elas e recebe as demais páginas sob demanda
+    uint32_t paginasIniciais = PALAVRAS_CACHE_CONTIGUA >> BITS_PAGINA_INSTRUCOES;
+
+    maquina->cacheInstrucoes = (InstrucaoDecodificada *)calloc(PALAVRAS_CACHE_CONTIGUA, sizeof(InstrucaoDecodificada));
+    maquina->paginasInstrucoes = (InstrucaoDecodificada **)calloc(PALAVRAS_MEMORIA >> BITS_PAGINA_INSTRUCOES, sizeof(InstrucaoDecodificada *));
+    maquina->paginasAlocadas = (uint32_t *)malloc(MAXIMO_PAGINAS_INSTRUCOES * sizeof(uint32_t));
+    maquina->totalPaginasAlocadas = 0;
+
+    for(uint32_t i = 0; i < paginasIniciais; i++)
+        maquina->paginasInstrucoes[i] = maquina->cacheInstrucoes + (i << BITS_PAGINA_INSTRUCOES);
+
+#ifdef BLOCOS_BASICOS
+    // Nenhum bloco traduzido
+    maquina->tabelaBlocos = (Bloco **)calloc(ENTRADAS_TABELA_BLOCOS, sizeof(Bloco *));
+    maquina->palavrasEmBlocos = (uint8_t *)calloc(ENTRADAS_TABELA_BLOCOS, sizeof(uint8_t));
+#endif
+
+#ifdef JIT_X86_64
+    inicializar_jit(maquina);
+#endif
+
+#ifdef PERFIL_SUPERINSTRUCOES
+    // Nenhuma sequência contada
+    if(maquina->arquivoPerfil)
+        maquina->perfil = (SequenciaPerfil *)calloc(ENTRADAS_PERFIL, sizeof(SequenciaPerfil));
+#endif
+
+    // Adicionando as instruções na memória
+    memcpy(maquina->MEM, imagem, tamanhoImagem * sizeof(uint32_t));
+
+#ifdef TRADUCAO_ANTECIPADA
+    // Tradução da imagem carregada, gerada na primeira execução e reaproveitada nas seguintes
+    carregar_traducao_antecipada(maquina, tamanhoImagem);
+#endif
+
+    // Alocando memória para o output do terminal
+    maquina->outputTerminal = (char *)malloc(TAMANHO_BASE_OUTPUT * sizeof(char));
+
+    inicializar_trace(maquina);
+
+    iniciar_execucao(maquina);
+
+    return 1;
+}
+
+void *reservar_memoria(size_t tamanho)
+{
+    // Apenas o espaço de endereços é reservado (MAP_NORESERVE): o sistema aloca cada página, zerada,
+    // no primeiro acesso
+    void *memoria = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    return memoria == MAP_FAILED ? NULL : memoria;
+}
+
+InstrucaoDecodificada *obter_instrucao(Poxim *maquina, uint32_t pc)
+{
+    InstrucaoDecodificada *pagina = maquina->paginasInstrucoes[pc >> (BITS_PAGINA_INSTRUCOES + 2)];
+
+    if(!pagina)
+        pagina = alocar_pagina_instrucoes(maquina, pc >> (BITS_PAGINA_INSTRUCOES + 2));
+
+    return &pagina[(pc >> 2) & ((1u << BITS_PAGINA_INSTRUCOES) - 1)];
+}
+
+InstrucaoDecodificada *buscar_instrucao(Poxim *maquina, uint32_t pc)
+{
+    // PC desalinhado: fora do cache, sem superinstruções nem fusões, que seguem as entradas alinhadas
+    if(pc & 3) {
+        decodificar_palavra(&maquina->instrucaoAvulsa, maquina->MEM[pc >> 2], pc);
+        return &maquina->instrucaoAvulsa;
+    }
+
+    InstrucaoDecodificada *decodificada = obter_instrucao(maquina, pc);
+
+    if(!decodificada->valida)
+        decodificar_instrucao(maquina, decodificada, pc);
+
+    return decodificada;
+}
+
+InstrucaoDecodificada *alocar_pagina_instrucoes(Poxim *maquina, uint32_t indice)
+{
+    // Limite de páginas alocadas: todas são descartadas, e só as instruções executadas daqui em diante voltam à
+    // cache. Nenhuma entrada descartada está em uso, já que as páginas só são alocadas ao buscar a próxima instrução
+    if(maquina->totalPaginasAlocadas == MAXIMO_PAGINAS_INSTRUCOES)
+        descartar_paginas_instrucoes(maquina, 0);
+
+    InstrucaoDecodificada *pagina = (InstrucaoDecodificada *)calloc(1u << BITS_PAGINA_INSTRUCOES, sizeof(InstrucaoDecodificada));
+
+    maquina->paginasInstrucoes[indice] = pagina;
+    maquina->paginasAlocadas[maquina->totalPaginasAlocadas++] = indice;
+
+    return pagina;
+}
+
+void descartar_paginas_instrucoes(Poxim *maquina, uint32_t primeira)
+{
+    // Páginas alocadas sob demanda a partir da página `primeira`; as do início da memória nunca são descartadas
+    uint32_t mantidas = 0;
+
+    for(uint32_t i = 0; i < maquina->totalPaginasAlocadas; i++) {
+        uint32_t indice = maquina->paginasAlocadas[i];
+
+        if(indice < primeira) {
+            maquina->paginasAlocadas[mantidas++] = indice;
+            continue;
+        }
+
+        free(maquina->paginasInstrucoes[indice]);
+        maquina->paginasInstrucoes[indice] = NULL;
+    }
+
+    maquina->totalPaginasAlocadas = mantidas;
+}
+
+uint8_t entradas_contiguas(uint32_t pc, uint32_t quantidade)
+{
+    // Superinstruções e pares fundidos leem as entradas seguintes da cache, contíguas apenas no início da memória
+    // e dentro de uma mesma página
+    uint32_t indice = pc >> 2;
+
+    return indice + quantidade <= PALAVRAS_CACHE_CONTIGUA ||
+        (indice & ((1u << BITS_PAGINA_INSTRUCOES) - 1)) + quantidade <= (1u << BITS_PAGINA_INSTRUCOES);
+}
+
+void iniciar_execucao(Poxim *maquina)
+{
+    // Nenhum evento agendado
+    for(int evento = 0; evento < TOTAL_EVENTOS; evento++)
+        maquina->eventos[evento] = EVENTO_INATIVO;
+
+    maquina->proximoEvento = EVENTO_INATIVO;
+
+    // Inserindo mensagem de início de execução no arquivo de output (no trace binário, o cabeçalho)
+    if(maquina->traceBinario && maquina->saida) {
+        uint32_t tamanhoRegistro = sizeof(PassoTrace);
+
+        fwrite(ASSINATURA_TRACE_BINARIO, sizeof(char), sizeof(ASSINATURA_TRACE_BINARIO), maquina->saida);
+        fwrite(&tamanhoRegistro, sizeof(uint32_t), 1, maquina->saida);
+        maquina->registrosTrace = 0;
+    } else {
+        trace_iniciar_linha(maquina);
+        trace_texto(maquina, "[START OF SIMULATION]\n");
+    }
+
+#ifdef TRACE_ASSINCRONO
+    // A partir daqui o buffer do trace pertence à thread do trace, até o fim da execução
+    if(maquina->modoTrace == TRACE_COMPLETO)
+        iniciar_trace_assincrono(maquina);
+#endif
+}
+
+void finalizar_simulador(Poxim *maquina)
+{
+    encerrar_execucao(maquina);
+
+#ifdef CACHE_RESULTADOS
+    // Apenas a saída de uma simulação concluída é guardada
+    if(maquina->caminhoResultado && !maquina->emExecucao)
+        guardar_resultado(maquina);
+#endif
+
+    liberar_simulador(maquina);
+}
+
+void encerrar_execucao(Poxim *maquina)
+{
+#ifdef TRACE_ASSINCRONO
+    // Os registros pendentes são escritos antes do terminal e da mensagem de fim
+    if(maquina->modoTrace == TRACE_COMPLETO)
+        encerrar_trace_assincrono(maquina);
+#endif
+
+    if(maquina->tamanhoOutput)
+        imprimir_output_terminal(maquina);
+
+    if(maquina->modoTrace == TRACE_DESLIGADO)
+        imprimir_resumo_execucao(maquina);
+
+    // Inserindo mensagem de final de execução no arquivo de output (no trace binário, o registro de fim, com que
+    // --render distingue um trace completo de um truncado)
+    if(!maquina->traceBinario) {
+        trace_iniciar_linha(maquina);
+        trace_texto(maquina, "[END OF SIMULATION]\n");
+    }
+
+    trace_descarregar(maquina);
+
+    if(maquina->traceBinario && maquina->saida) {
+        PassoTrace passo = {PASSO_FIM, 0, 0, {(uint32_t)maquina->registrosTrace, (uint32_t)(maquina->registrosTrace >> 32), 0, 0, 0, 0}};
+
+        fwrite(&passo, sizeof(PassoTrace), 1, maquina->saida);
+    }
+
+    // Fechando arquivo de saída
+    if(maquina->saida)
+        fclose(maquina->saida);
+
+    maquina->saida = NULL;
+}
+
+void liberar_simulador(Poxim *maquina)
+{
+    // Fechando arquivo de debug (as máquinas do modo lote não têm um)
+    if(maquina->debug)
+        fclose(maquina->debug);
+
+    // Liberando a memória reservada para o array de memória
+    munmap(maquina->MEM, (size_t)PALAVRAS_MEMORIA * sizeof(uint32_t));
+
+    // Liberando a cache de instruções pré-decodificadas
+    descartar_paginas_instrucoes(maquina, 0);
+    free(maquina->paginasAlocadas);
+    free(maquina->paginasInstrucoes);
+    free(maquina->cacheInstrucoes);
+
+#ifdef BLOCOS_BASICOS
+    // Liberando os blocos traduzidos
+    for(int i = 0; i < ENTRADAS_TABELA_BLOCOS; i++)
+        free(maquina->tabelaBlocos[i]);
+
+    free(maquina->tabelaBlocos);
+    free(maquina->palavrasEmBlocos);
+#endif
+
+#ifdef JIT_X86_64
+    // Liberando a área do código nativo
+    if(maquina->codigoJit)
+        munmap(maquina->codigoJit, CAPACIDADE_CODIGO_JIT);
+#endif
+
+#ifdef PERFIL_SUPERINSTRUCOES
+    // Gravando e liberando o perfil
+    if(maquina->perfil)
+        gravar_perfil(maquina);
+
+    free(maquina->perfil);
+#endif
+
+#ifdef TRADUCAO_ANTECIPADA
+    // Descarregando a tradução antecipada
+    if(maquina->bibliotecaTraducao)
+        dlclose(maquina->bibliotecaTraducao);
+
+    free(maquina->traducoesAntecipadas);
+    free(maquina->imagemCarregada);
+#endif
+
+    // Liberando memória alocada para o output do terminal
+    free(maquina->outputTerminal);
+
+    // Liberando o buffer e a cache de desmontagem do trace
+    free(maquina->bufferTrace);
+    free(maquina->cacheDesmontagem);
+
+    // Liberando a máquina
+    free(maquina);
+}
+
+// API DA BIBLIOTECA (poxim.h)
+
+Poxim *poxim_create(void)
+{
+    Poxim *maquina = criar_maquina();
+
+    // Sem arquivo de saída, nada do trace é formatado até que seja pedido
+    maquina->modoTrace = TRACE_DESLIGADO;
+
+    return maquina;
+}
+
+void poxim_destroy(Poxim *maquina)
+{
+    if(!maquina)
+        return;
+
+    if(maquina->inicializada) {
+        finalizar_simulador(maquina);
+        return;
+    }
+
+    // A simulação não começou: apenas o arquivo de saída foi aberto
+    if(maquina->saida)
+        fclose(maquina->saida);
+
+    free(maquina);
+}
+
+int poxim_set_output(Poxim *maquina, const char *caminho)
+{
+    if(maquina->inicializada)
+        return -1;
+
+    FILE *saida = fopen(caminho, "w");
+
+    if(!saida) {
+        fprintf(stderr, "Não foi possível abrir o arquivo de saída: %s\n", caminho);
+        return -1;
+    }
+
+    if(maquina->saida)
+        fclose(maquina->saida);
+
+    maquina->saida = saida;
+
+    return 0;
+}
+
+int poxim_set_trace(Poxim *maquina, PoximTrace modo)
+{
+    if(maquina->inicializada)
+        return -1;
+
+    switch(modo) {
+        case POXIM_TRACE_OFF: maquina->modoTrace = TRACE_DESLIGADO; break;
+        case POXIM_TRACE_TERMINAL: maquina->modoTrace = TRACE_TERMINAL; break;
+        case POXIM_TRACE_FULL: maquina->modoTrace = TRACE_COMPLETO; break;
+        case POXIM_TRACE_BINARY: maquina->modoTrace = TRACE_COMPLETO; break;
+        default: return -1;
+    }
+
+    maquina->traceBinario = modo == POXIM_TRACE_BINARY;
+
+    return 0;
+}
+
+int poxim_set_device(Poxim *maquina, PoximDevice dispositivo, PoximDeviceRead ler, PoximDeviceWrite escrever, void *contexto)
+{
+    if(dispositivo >= POXIM_TOTAL_DEVICES)
+        return -1;
+
+    maquina->dispositivos[dispositivo] = (Dispositivo){ler, escrever, contexto};
+
+    return 0;
+}
+
+int poxim_load_image(Poxim *maquina, const uint32_t *palavras, uint32_t quantidade)
+{
+    if(maquina->inicializada)
+        return -1;
+
+    if(quantidade > PALAVRAS_MEMORIA) {
+        fprintf(stderr, "Imagem maior que a memória: %u palavras\n", quantidade);
+        return -1;
+    }
+
+    if(!inicializar_simulador(maquina, palavras, quantidade))
+        return -1;
+
+    maquina->inicializada = 1;
+
+    return 0;
+}
+
+int poxim_load_hex(Poxim *maquina, const char *caminho)
+{
+    Imagem imagem;
+
+    if(!ler_imagem(caminho, &imagem))
+        return -1;
+
+    int resultado = poxim_load_image(maquina, imagem.palavras, imagem.quantidade);
+
+    liberar_imagem(&imagem);
+
+    return resultado;
+}
+
+uint64_t poxim_run(Poxim *maquina, uint64_t limite)
+{
+    uint64_t inicio = maquina->instrucoesExecutadas;
+
+    if(!maquina->inicializada || !maquina->emExecucao || !limite)
+        return 0;
+
+    // O limite é um evento como os demais: os motores de execução param na instrução exata
+    if(limite < EVENTO_INATIVO - inicio)
+        agendar_evento(maquina, EVENTO_PAUSA, inicio + limite);
+
+    executar_maquina(maquina);
+
+    // Parada pelo limite: a simulação continua na próxima chamada
+    if(maquina->pausada) {
+        maquina->pausada = 0;
+        maquina->emExecucao = 1;
+    }
+
+    return maquina->instrucoesExecutadas - inicio;
+}
+
+uint64_t poxim_step(Poxim *maquina)
+{
+    return poxim_run(maquina, 1);
+}
+
+int poxim_running(Poxim *maquina)
+{
+    return maquina->inicializada && maquina->emExecucao;
+}
+
+uint64_t poxim_instructions(Poxim *maquina)
+{
+    return maquina->instrucoesExecutadas;
+}
+
+uint32_t poxim_get_register(Poxim *maquina, uint32_t indice)
+{
+    if(indice >= 32)
+        return 0;
+
+    // O SR só tem as flags da última operação depois de calculadas
+    if(indice == SR)
+        materializar_flags(maquina);
+
+    return maquina->R[indice];
+}
+
+int poxim_set_register(Poxim *maquina, uint32_t indice, uint32_t valor)
+{
+    if(indice >= 32)
+        return -1;
+
+    if(!indice)
+        return 0;
+
+    // Flags pendentes sobrescreveriam o SR escrito; com o IE alterado, as interrupções pendentes são verificadas
+    if(indice == SR) {
+        materializar_flags(maquina);
+
+        if(maquina->interrupcoesAgendadas)
+            agendar_evento(maquina, EVENTO_INTERRUPCOES, maquina->instrucoesExecutadas);
+    }
+
+    maquina->R[indice] = valor;
+
+    return 0;
+}
+
+int poxim_read_memory(Poxim *maquina, uint32_t endereco, uint32_t *palavras, uint32_t quantidade)
+{
+    if(!maquina->inicializada || endereco % 4 || quantidade > PALAVRAS_MEMORIA - endereco / 4)
+        return -1;
+
+    memcpy(palavras, &maquina->MEM[endereco >> 2], quantidade * sizeof(uint32_t));
+
+    return 0;
+}
+
+int poxim_write_memory(Poxim *maquina, uint32_t endereco, const uint32_t *palavras, uint32_t quantidade)
+{
+    if(!maquina->inicializada || endereco % 4 || quantidade > PALAVRAS_MEMORIA - endereco / 4)
+        return -1;
+
+    for(uint32_t i = 0; i < quantidade; i++) {
+        maquina->MEM[(endereco >> 2) + i] = palavras[i];
+        invalidar_instrucao_decodificada(maquina, (endereco >> 2) + i);
+    }
+
+    return 0;
+}
+
+void imprimir_output_terminal(Poxim *maquina)
+{
+    // O buffer sempre tem espaço após o último caractere (adicionar_caractere_output o amplia ao encher)
+    maquina->outputTerminal[maquina->tamanhoOutput] = '\0';
+
+    // O conteúdo do terminal pode ser maior que o buffer do trace: é escrito diretamente, após ele
+    trace_descarregar(maquina);
+
+    if(!maquina->saida)
+        return;
+
+    // No trace binário, um registro com o tamanho do conteúdo, seguido dele
+    if(maquina->traceBinario) {
+        PassoTrace passo = {PASSO_TERMINAL, 0, 0, {strlen(maquina->outputTerminal)}};
+
+        fwrite(&passo, sizeof(PassoTrace), 1, maquina->saida);
+        maquina->registrosTrace++;
+        fwrite(maquina->outputTerminal, sizeof(char), passo.valores[0], maquina->saida);
+        return;
+    }
+
+    fprintf(maquina->saida, "[TERMINAL]\n");
+    fprintf(maquina->saida, "%s", maquina->outputTerminal);
+    fprintf(maquina->saida, "\n");
+}
+
+void imprimir_resumo_execucao(Poxim *maquina)
+{
+    trace_iniciar_linha(maquina);
+    trace_texto(maquina, "[INTERRUPTIONS]\nINVALID INSTRUCTION=");
+    trace_decimal(maquina, maquina->totalInstrucoesInvalidas);
+    trace_texto(maquina, "\nSOFTWARE=");
+    trace_decimal(maquina, maquina->totalInterrupcoesSoftware);
+    trace_caractere(maquina, '\n');
+
+    for(int prioridade = 1; prioridade <= 4; prioridade++) {
+        trace_texto(maquina, "HARDWARE ");
+        trace_decimal(maquina, prioridade);
+        trace_caractere(maquina, '=');
+        trace_decimal(maquina, maquina->totalInterrupcoesHardware[prioridade]);
+        trace_caractere(maquina, '\n');
+    }
+
+    trace_texto(maquina, "[REGISTERS]\n");
+
+    materializar_flags(maquina);
+
+    for(int i = 0; i < 32; i++) {
+        trace_iniciar_linha(maquina);
+        trace_registrador_maiusculo(maquina, i);
+        trace_caractere(maquina, '=');
+        trace_hexadecimal(maquina, maquina->R[i], 8);
+        trace_caractere(maquina, '\n');
+    }
+}
+
+void registrar_instrucao_invalida(Poxim *maquina, uint32_t pc)
+{
+    maquina->totalInstrucoesInvalidas++;
+
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INSTRUCAO_INVALIDA, pc, 0, {0}};
+        emitir_passo(maquina, &passo);
+    }
+}
+
+void registrar_interrupcao_software(Poxim *maquina)
+{
+    maquina->totalInterrupcoesSoftware++;
+
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INTERRUPCAO_SOFTWARE, 0, 0, {0}};
+        emitir_passo(maquina, &passo);
+    }
+}
+
+void registrar_interrupcao_hardware(Poxim *maquina, uint8_t prioridade)
+{
+    maquina->totalInterrupcoesHardware[prioridade]++;
+
+    if(maquina->modoTrace == TRACE_COMPLETO) {
+        PassoTrace passo = {PASSO_INTERRUPCAO_HARDWARE, 0, 0, {prioridade}};
+        emitir_passo(maquina, &passo);
+    }
+}
+
+void adicionar_caractere_output(Poxim *maquina, char caractere)
+{
+    maquina->outputTerminal[maquina->tamanhoOutput++] = caractere;
+
+    if(maquina->tamanhoOutput && maquina->tamanhoOutput % TAMANHO_BASE_OUTPUT == 0) {
+        int novoTamanho = (maquina->tamanhoOutput + TAMANHO_BASE_OUTPUT) * sizeof(char);
+        maquina->outputTerminal = (char *)realloc(maquina->outputTerminal, novoTamanho);
+    }
+}
+
+uint8_t ler_dispositivo(Poxim *maquina, PoximDevice dispositivo, uint32_t endereco, uint32_t *valor)
+{
+    Dispositivo *callbacks = &maquina->dispositivos[dispositivo];
+
+    return callbacks->ler && callbacks->ler(callbacks->contexto, endereco, valor);
+}
+
+uint8_t escrever_dispositivo(Poxim *maquina, PoximDevice dispositivo, uint32_t endereco, uint32_t valor)
+{
+    Dispositivo *callbacks = &maquina->dispositivos[dispositivo];
+
+    return callbacks->escrever && callbacks->escrever(callbacks->contexto, endereco, valor);
+}
+
+void registrar_regiao(Poxim *maquina, uint32_t inicio, uint32_t fim,
+    uint8_t (*ler)(Poxim *, uint32_t, uint8_t, uint32_t *), uint8_t (*escrever)(Poxim *, uint32_t, uint8_t, uint32_t))
+{
+    if(maquina->totalRegioes == MAXIMO_REGIOES_BARRAMENTO) {
+        fprintf(stderr, "Barramento de dispositivos cheio: região 0x%08X a 0x%08X ignorada\n", inicio, fim);
+        return;
+    }
+
+    // A janela do barramento cresce para conter a nova região
+    uint32_t inicioJanela = inicio, fimJanela = fim;
+
+    if(maquina->totalRegioes) {
+        if(maquina->inicioBarramento < inicioJanela)
+            inicioJanela = maquina->inicioBarramento;
+        if(maquina->inicioBarramento + maquina->extensaoBarramento > fimJanela)
+            fimJanela = maquina->inicioBarramento + maquina->extensaoBarramento;
+    }
+
+    maquina->barramento[maquina->totalRegioes++] = (RegiaoDispositivo){inicio, fim, ler, escrever};
+    maquina->inicioBarramento = inicioJanela;
+    maquina->extensaoBarramento = fimJanela - inicioJanela;
+}
+
+uint8_t ler_barramento(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t *valor)
+{
+    // Endereço na janela do barramento: a região que o contém, se houver, decide se o acesso é dela
+    for(int i = 0; i < maquina->totalRegioes; i++) {
+        RegiaoDispositivo *regiao = &maquina->barramento[i];
+
+        if(endereco >= regiao->inicio && endereco <= regiao->fim)
+            return regiao->ler && regiao->ler(maquina, endereco, tamanho, valor);
+    }
+
+    return 0;
+}
+
+uint8_t escrever_barramento(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t valor)
+{
+    for(int i = 0; i < maquina->totalRegioes; i++) {
+        RegiaoDispositivo *regiao = &maquina->barramento[i];
+
+        if(endereco >= regiao->inicio && endereco <= regiao->fim)
+            return regiao->escrever && regiao->escrever(maquina, endereco, tamanho, valor);
+    }
+
+    return 0;
+}
+
+uint8_t ler_terminal(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t *valor)
+{
+    // A leitura do terminal (l8 em 0x8888888A) só existe quando interceptada pelo programa que usa a biblioteca
+    if(tamanho != 1 || endereco != 0x8888888A || !ler_dispositivo(maquina, POXIM_DEVICE_TERMINAL, endereco, valor))
+        return 0;
+
+    *valor &= 0xFF;
+
+    return 1;
+}
+
+uint8_t escrever_terminal(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t valor)
+{
+    // s8 em 0x8888888B
+    if(tamanho != 1 || endereco != 0x8888888B)
+        return 0;
+
+    if(!escrever_dispositivo(maquina, POXIM_DEVICE_TERMINAL, endereco, valor & 0xFF))
+        adicionar_caractere_output(maquina, (char)valor);
+
+    return 1;
+}
+
+uint8_t ler_watchdog(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t *valor)
+{
+    // O watchdog só pode ser lido (l32 em 0x80808080) quando interceptado pelo programa que usa a biblioteca
+    return tamanho == 4 && endereco == 0x80808080 && ler_dispositivo(maquina, POXIM_DEVICE_WATCHDOG, endereco, valor);
+}
+
+uint8_t escrever_watchdog(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t valor)
+{
+    // s32 em 0x80808080
+    if(tamanho != 4 || endereco != 0x80808080)
+        return 0;
+
+    if(escrever_dispositivo(maquina, POXIM_DEVICE_WATCHDOG, endereco, valor))
+        return 1;
+
+    maquina->watchdog = valor;
+
+    // O contador decresce uma vez por instrução a partir desta e expira ao chegar a 0
+    if(maquina->watchdog)
+        agendar_evento(maquina, EVENTO_WATCHDOG, maquina->instrucoesExecutadas + (maquina->watchdog & ~(0b1 << 31)));
+    else
+        maquina->eventos[EVENTO_WATCHDOG] = EVENTO_INATIVO;
+
+    return 1;
+}
+
+uint8_t ler_fpu(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t *valor)
+{
+    // l32 nos registradores X, Y, Z e de controle (0x80808880 a 0x8080888C) e l8 no controle (0x8080888F)
+    if(tamanho == 1 && endereco != 0x8080888F)
+        return 0;
+
+    if(ler_dispositivo(maquina, POXIM_DEVICE_FPU, endereco, valor))
+        return 1;
+
+    if(endereco == 0x80808880)
+        *valor = maquina->fpuX_IEEE754 ? maquina->fpuX.u : maquina->fpuX.f;
+    else if(endereco == 0x80808884)
+        *valor = maquina->fpuY_IEEE754 ? maquina->fpuY.u : maquina->fpuY.f;
+    else if(endereco == 0x80808888) {
+        if(maquina->fpuZ_IEEE754)
+            memcpy(valor, &maquina->fpuZ.u, sizeof(uint32_t));
+        else
+            *valor = maquina->fpuZ.f;
+    }
+    else
+        *valor = maquina->fpuControle;
 
-    sprintf(instrucao, "s8 [%s%s%d],%s ", registradorX, (i >= 0) ? ("+") : (""), i, registradorZ);
-    fprintf(saida, "0x%08X:\t%-25s\tMEM[0x%08X]=%s=0x%02X\n", pcAtual, instrucao, endereco, str_upper(registradorZ), (uint8_t)R[z]);
+    return 1;
 }
 
-void _s16()
+uint8_t escrever_fpu(Poxim *maquina, uint32_t endereco, uint8_t tamanho, uint32_t valor)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
+    if(tamanho == 1 && endereco != 0x8080888F)
+        return 0;
 
-    ((uint16_t *)&MEM[(R[x] + i) >> 1])[1 - (R[x] + i) % 2] = (int16_t)R[z];
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-
-    sprintf(instrucao, "s16 [%s%s%d],%s ", registradorX, (i >= 0) ? ("+") : (""), i, registradorZ);
-    fprintf(saida, "0x%08X:\t%-25s\tMEM[0x%08X]=%s=0x%04X\n", pcAtual, instrucao, (R[x] + i) << 1, str_upper(registradorZ), R[z]);
-}
-
-void _s32()
-{
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint32_t endereco = (R[x] + i) << 2;
+    if(escrever_dispositivo(maquina, POXIM_DEVICE_FPU, endereco, tamanho == 1 ? valor & 0xFF : valor))
+        return 1;
 
-    if(endereco == 0x80808080) {
-        watchdog = R[z];
-        contador = watchdog & ~(0b1 << 31);
-    } else if(endereco == 0x80808880) {
-        fpuX.f = R[z];
-        fpuX_IEEE754 = 0;
+    if(endereco == 0x80808880) {
+        maquina->fpuX.f = valor;
+        maquina->fpuX_IEEE754 = 0;
     } else if(endereco == 0x80808884) {
-        fpuY.f = R[z];
-        fpuY_IEEE754 = 0;
+        maquina->fpuY.f = valor;
+        maquina->fpuY_IEEE754 = 0;
     } else if(endereco == 0x80808888) {
-        fpuZ.f = R[z];
-        fpuZ_IEEE754 = 1;
-    } else if(endereco == 0x8080888C) {
-        fpuControle = R[z] & (0b11111);
+        maquina->fpuZ.f = valor;
+        maquina->fpuZ_IEEE754 = 1;
     } else {
-        MEM[R[x] + i] = R[z];
+        // s32 no controle guarda só a operação; s8 guarda o byte inteiro
+        maquina->fpuControle = tamanho == 4 ? valor & (0b11111) : valor;
+        agendar_evento(maquina, EVENTO_FPU_INICIO, maquina->instrucoesExecutadas);
     }
 
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-    formatar_string_registrador(x, registradorX);
-
-    sprintf(instrucao, "s32 [%s%s%d],%s ", registradorX, (i >= 0) ? ("+") : (""), i, registradorZ);
-    fprintf(saida, "0x%08X:\t%-25s\tMEM[0x%08X]=%s=0x%08X\n", pcAtual, instrucao, endereco, str_upper(registradorZ), R[z]);
+    return 1;
 }
 
-void _callf()
+uint8_t ler_imagem(const char *caminho, Imagem *imagem)
 {
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-    int16_t i = R[IR] & 0xFFFF;
-    uint8_t i15 = i >> 15;
-    int32_t i15_i;
-    uint32_t spAtual = R[SP];
+    int descritor = open(caminho, O_RDONLY);
+    struct stat estado;
+
+    if(descritor < 0 || fstat(descritor, &estado)) {
+        fprintf(stderr, "Não foi possível abrir o arquivo de entrada: %s\n", caminho);
+        if(descritor >= 0)
+            close(descritor);
+        return 0;
+    }
 
-    if(i15 == 1)
-        i15_i = (int32_t)i | 0xffffffff;
-    else
-        i15_i = (int32_t)i;
+    // O arquivo inteiro é mapeado (um arquivo vazio não pode ser mapeado e não tem palavras)
+    size_t tamanho = estado.st_size;
+    char *conteudo = tamanho ? (char *)mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, descritor, 0) : NULL;
 
-    MEM[R[SP] >> 2] = R[PC] + 4;
-    R[SP] -= 4;
-    R[PC] = ((int32_t)R[x] + i15_i) << 2;
-    R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    close(descritor);
 
-    // Formatação da saída
-    formatar_string_registrador(x, registradorX);
+    if(conteudo == MAP_FAILED) {
+        fprintf(stderr, "Não foi possível ler o arquivo de entrada: %s\n", caminho);
+        return 0;
+    }
 
-    sprintf(instrucao, "call [%s%s%d]", registradorX, (i15_i >= 0) ? ("+") : (""), i15_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X,MEM[0x%08X]=0x%08X\n", pcAtual, instrucao, R[PC] + 4, spAtual, pcAtual + 4);
-}
+    *imagem = (Imagem){NULL, 0, NULL, 0};
 
-void _ret()
-{
-    R[SP] += 4;
-    R[PC] = MEM[R[SP] >> 2];
-    R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    // Imagem binária: as palavras são carregadas do próprio mapeamento, sem cópia intermediária
+    if(tamanho >= sizeof(ASSINATURA_IMAGEM) && !memcmp(conteudo, ASSINATURA_IMAGEM, sizeof(ASSINATURA_IMAGEM))) {
+        size_t bytes = tamanho - sizeof(ASSINATURA_IMAGEM);
 
-    // Formatação da saída
-    sprintf(instrucao, "ret");
-    fprintf(saida, "0x%08X:\t%-25s\tPC=MEM[0x%08X]=0x%08X\n", pcAtual, instrucao, R[SP], R[PC] + 4);
-}
+        if(bytes % sizeof(uint32_t) || bytes / sizeof(uint32_t) > PALAVRAS_MEMORIA) {
+            fprintf(stderr, "Imagem binária inválida: %s\n", caminho);
+            munmap(conteudo, tamanho);
+            return 0;
+        }
 
-void _reti()
-{
-    uint32_t sp_ipc, sp_cr;
+        *imagem = (Imagem){(uint32_t *)(conteudo + sizeof(ASSINATURA_IMAGEM)), bytes / sizeof(uint32_t), conteudo, tamanho};
+        return 1;
+    }
 
-    R[SP] += 4;
-    sp_ipc = R[SP];
-    R[IPC] = MEM[R[SP] >> 2];
+    // Arquivo .hex: cada palavra ocupa ao menos 10 caracteres ("0x" e 8 dígitos) e um separador
+    imagem->palavras = (uint32_t *)malloc((tamanho / 11 + 1) * sizeof(uint32_t));
 
-    R[SP] += 4;
-    sp_cr = R[SP];
-    R[CR] = MEM[R[SP] >> 2];
+    uint8_t interpretada = interpretar_imagem_hex(conteudo, tamanho, imagem->palavras, &imagem->quantidade);
 
-    R[SP] += 4;
-    R[PC] = MEM[R[SP] >> 2];
+    if(conteudo)
+        munmap(conteudo, tamanho);
+
+    if(interpretada)
+        return 1;
 
-    R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    // Fora do formato de uma palavra 0xXXXXXXXX por campo, o arquivo é lido com fscanf, como qualquer texto
+    free(imagem->palavras);
+    imagem->palavras = ler_imagem_hex(caminho, &imagem->quantidade);
 
-    // Formatação da saída
-    sprintf(instrucao, "reti");
-    fprintf(saida,
-        "0x%08X:\t%-25s\tIPC=MEM[0x%08X]=0x%08X,CR=MEM[0x%08X]=0x%08X,PC=MEM[0x%08X]=0x%08X\n",
-        pcAtual,
-        instrucao,
-        sp_ipc,
-        R[IPC],
-        sp_cr,
-        R[CR],
-        R[SP],
-        R[PC] + 4
-    );
+    return imagem->palavras != NULL;
 }
 
-void _cbr()
+void liberar_imagem(Imagem *imagem)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
-
-    R[z] = R[z] & ~(0b1 << x);
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-
-    sprintf(instrucao, "cbr %s[%u]", registradorZ, x);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=0x%08X\n", pcAtual, instrucao, str_upper(registradorZ), R[z]);
+    if(imagem->mapeamento)
+        munmap(imagem->mapeamento, imagem->tamanhoMapeamento);
+    else
+        free(imagem->palavras);
 }
 
-void _sbr()
+uint8_t interpretar_imagem_hex(const char *texto, size_t tamanho, uint32_t *imagem, uint32_t *quantidade)
 {
-    uint8_t z = (R[IR] & (0b11111 << 21)) >> 21;
-    uint8_t x = (R[IR] & (0b11111 << 16)) >> 16;
+    size_t i = 0;
 
-    R[z] = R[z] | (0b1 << x);
+    *quantidade = 0;
 
-    // R[0] não pode armazenar um valor diferente de 0
-    R[0] = 0;
-
-    // Formatação da saída
-    formatar_string_registrador(z, registradorZ);
-
-    sprintf(instrucao, "sbr %s[%u]", registradorZ, x);
-    fprintf(saida, "0x%08X:\t%-25s\t%s=0x%08X\n", pcAtual, instrucao, str_upper(registradorZ), R[z]);
-}
+    // Campos "0x" (ou "0X") com exatamente 8 dígitos, separados por espaços ou quebras de linha. Devolve 0 no
+    // primeiro campo em outro formato, e a imagem é então lida por ler_imagem_hex
+    while(1) {
+        while(i < tamanho && (texto[i] == ' ' || (texto[i] >= '\t' && texto[i] <= '\r')))
+            i++;
 
-void _bae()
-{
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+        if(i == tamanho)
+            return 1;
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+        if(tamanho - i < 10 || texto[i] != '0' || (texto[i + 1] | 0x20) != 'x' ||
+            !decodificar_palavra_hexadecimal(texto + i + 2, &imagem[*quantidade]))
+            return 0;
 
-    uint8_t cy = R[SR] & 0b1;
+        i += 10;
 
-    if(cy == 0)
-        R[PC] += i25_i << 2;
+        if(i < tamanho && texto[i] != ' ' && (texto[i] < '\t' || texto[i] > '\r'))
+            return 0;
 
-    // Formatação da saída
-    sprintf(instrucao, "bae %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+        if(++(*quantidade) > PALAVRAS_MEMORIA)
+            return 0;
+    }
 }
 
-void _bat()
+uint8_t decodificar_palavra_hexadecimal(const char *digitos, uint32_t *palavra)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
-
-    uint8_t cy = R[SR] & 0b1;
-    uint8_t zn = (R[SR] & (0b1 << 6)) >> 6;
-
-    if(zn == 0 && cy == 0)
-        R[PC] += i25_i << 2;
+#ifdef __SSE2__
+    // Os 8 dígitos de uma vez: cada byte é validado como dígito ou letra de 'a' a 'f' (maiúscula ou minúscula)
+    // e convertido no seu valor
+    __m128i caracteres = _mm_loadl_epi64((const __m128i *)digitos);
+    __m128i minusculos = _mm_or_si128(caracteres, _mm_set1_epi8(0x20));
+    __m128i numericos = _mm_and_si128(_mm_cmpgt_epi8(caracteres, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(caracteres, _mm_set1_epi8('9' + 1)));
+    __m128i letras = _mm_and_si128(_mm_cmpgt_epi8(minusculos, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(minusculos, _mm_set1_epi8('f' + 1)));
+
+    if((_mm_movemask_epi8(_mm_or_si128(numericos, letras)) & 0xFF) != 0xFF)
+        return 0;
+
+    __m128i valores = _mm_or_si128(_mm_and_si128(numericos, _mm_sub_epi8(caracteres, _mm_set1_epi8('0'))),
+        _mm_and_si128(letras, _mm_sub_epi8(minusculos, _mm_set1_epi8('a' - 10))));
+
+    // Cada par de dígitos (o mais significativo no byte baixo de 16 bits) vira um byte, e os 4 bytes, do mais
+    // significativo ao menos significativo, são empacotados no início do vetor
+    __m128i pares = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(valores, 4), _mm_srli_epi16(valores, 8)), _mm_set1_epi16(0xFF));
+
+    *palavra = __builtin_bswap32((uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(pares, _mm_setzero_si128())));
+#else
+    *palavra = 0;
+
+    for(int i = 0; i < 8; i++) {
+        char caractere = digitos[i], minusculo = caractere | 0x20;
+
+        if(caractere >= '0' && caractere <= '9')
+            *palavra = (*palavra << 4) | (caractere - '0');
+        else if(minusculo >= 'a' && minusculo <= 'f')
+            *palavra = (*palavra << 4) | (minusculo - 'a' + 10);
+        else
+            return 0;
+    }
+#endif
 
-    // Formatação da saída
-    sprintf(instrucao, "bat %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    return 1;
 }
 
-void _bbe()
+int gravar_imagem_binaria(int argc, char *argv[])
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    if(argc != 4) {
+        fprintf(stderr, "Uso: %s --pack <entrada.hex> <imagem.bin>\n", argv[0]);
+        return 1;
+    }
 
-    uint8_t cy = R[SR] & 0b1;
-    uint8_t zn = (R[SR] & (0b1 << 6)) >> 6;
+    Imagem imagem;
 
-    if(zn == 1 || cy == 1)
-        R[PC] += i25_i << 2;
+    if(!ler_imagem(argv[2], &imagem))
+        return 1;
 
-    // Formatação da saída
-    sprintf(instrucao, "bbe %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
-}
+    FILE *arquivo = fopen(argv[3], "wb");
 
-void _bbt()
-{
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    if(!arquivo) {
+        fprintf(stderr, "Não foi possível gravar a imagem: %s\n", argv[3]);
+        liberar_imagem(&imagem);
+        return 1;
+    }
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    // Assinatura e palavras, prontas para serem mapeadas e copiadas de uma vez por ler_imagem
+    uint8_t gravada = fwrite(ASSINATURA_IMAGEM, sizeof(ASSINATURA_IMAGEM), 1, arquivo) == 1 &&
+        fwrite(imagem.palavras, sizeof(uint32_t), imagem.quantidade, arquivo) == imagem.quantidade;
 
-    uint8_t cy = R[SR] & 0b1;
+    if(fclose(arquivo) || !gravada) {
+        fprintf(stderr, "Não foi possível gravar a imagem: %s\n", argv[3]);
+        liberar_imagem(&imagem);
+        return 1;
+    }
 
-    if(cy == 1)
-        R[PC] += i25_i << 2;
+    liberar_imagem(&imagem);
 
-    // Formatação da saída
-    sprintf(instrucao, "bbt %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    return 0;
 }
 
-void _beq()
+uint32_t *ler_imagem_hex(const char *caminho, uint32_t *quantidade)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    FILE *entrada = fopen(caminho, "r");
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
-
-    uint8_t zn = (R[SR] & (0b1 << 6)) >> 6;
+    if(!entrada) {
+        fprintf(stderr, "Não foi possível abrir o arquivo de entrada: %s\n", caminho);
+        return NULL;
+    }
 
-    if(zn == 1)
-        R[PC] += i25_i << 2;
+    // Uma palavra em hexadecimal por campo, até o fim do arquivo ou o primeiro campo inválido. O vetor começa
+    // com 32KiB e dobra ao encher, até o tamanho da memória
+    uint32_t capacidade = 32 * 1024 / 4, palavra;
+    uint32_t *imagem = (uint32_t *)malloc(capacidade * sizeof(uint32_t));
 
-    // Formatação da saída
-    sprintf(instrucao, "beq %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
-}
+    *quantidade = 0;
 
-void _bge()
-{
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    while(fscanf(entrada, "%X", &palavra) == 1) {
+        if(*quantidade == PALAVRAS_MEMORIA) {
+            fprintf(stderr, "Imagem maior que a memória: %s\n", caminho);
+            fclose(entrada);
+            free(imagem);
+            return NULL;
+        }
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+        if(*quantidade == capacidade) {
+            capacidade *= 2;
+            imagem = (uint32_t *)realloc(imagem, capacidade * sizeof(uint32_t));
+        }
 
-    uint8_t sn = (R[SR] & (0b1 << 4)) >> 4;
-    uint8_t ov = (R[SR] & (0b1 << 3)) >> 3;
+        imagem[(*quantidade)++] = palavra;
+    }
 
-    if(sn == ov)
-        R[PC] += i25_i << 2;
+    fclose(entrada);
 
-    // Formatação da saída
-    sprintf(instrucao, "bge %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    return imagem;
 }
 
-void _bgt()
+#ifdef TRACE_ASSINCRONO
+void iniciar_trace_assincrono(Poxim *maquina)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    maquina->filaTrace = (PassoTrace *)malloc(CAPACIDADE_FILA_TRACE * sizeof(PassoTrace));
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    // Fila vazia, também quando a máquina é reaproveitada para outra execução
+    atomic_store_explicit(&maquina->inicioFilaTrace, 0, memory_order_relaxed);
+    atomic_store_explicit(&maquina->fimFilaTrace, 0, memory_order_relaxed);
+    atomic_store_explicit(&maquina->traceEncerrado, 0, memory_order_relaxed);
+    maquina->inicioFilaProdutor = 0;
 
-    uint8_t zn = (R[SR] & (0b1 << 6)) >> 6;
-    uint8_t sn = (R[SR] & (0b1 << 4)) >> 4;
-    uint8_t ov = (R[SR] & (0b1 << 3)) >> 3;
-
-    if(zn == 0 && sn == ov)
-        R[PC] += i25_i << 2;
-
-    // Formatação da saída
-    sprintf(instrucao, "bgt %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    pthread_create(&maquina->threadTrace, NULL, executar_thread_trace, maquina);
 }
 
-void _biv()
+void encerrar_trace_assincrono(Poxim *maquina)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    atomic_store_explicit(&maquina->traceEncerrado, 1, memory_order_release);
+    pthread_join(maquina->threadTrace, NULL);
 
-    uint8_t iv = (R[SR] & (0b1 << 2)) >> 2;
-
-    if(iv)
-        R[PC] += i25_i << 2;
-
-    // Formatação da saída
-    sprintf(instrucao, "biv %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    free(maquina->filaTrace);
 }
 
-void _ble()
+void *executar_thread_trace(void *argumento)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    Poxim *maquina = (Poxim *)argumento;
+    uint32_t inicio = atomic_load_explicit(&maquina->inicioFilaTrace, memory_order_relaxed);
 
-    uint8_t zn = (R[SR] & (0b1 << 6)) >> 6;
-    uint8_t sn = (R[SR] & (0b1 << 4)) >> 4;
-    uint8_t ov = (R[SR] & (0b1 << 3)) >> 3;
+    while(1) {
+        // O encerramento é lido antes do fim da fila: nenhum registro publicado antes dele fica para trás
+        uint8_t encerrado = atomic_load_explicit(&maquina->traceEncerrado, memory_order_acquire);
+        uint32_t fim = atomic_load_explicit(&maquina->fimFilaTrace, memory_order_acquire);
 
-    if(zn == 1 || sn != ov)
-        R[PC] += i25_i << 2;
-
-    // Formatação da saída
-    sprintf(instrucao, "ble %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
-}
+        if(inicio == fim) {
+            if(encerrado)
+                break;
 
-void _blt()
-{
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+            sched_yield();
+            continue;
+        }
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+        // Formata os registros disponíveis, liberando espaço ao produtor a cada bloco
+        while(inicio != fim) {
+            escrever_passo(maquina, &maquina->filaTrace[inicio & (CAPACIDADE_FILA_TRACE - 1)]);
+            inicio++;
 
-    uint8_t sn = (R[SR] & (0b1 << 4)) >> 4;
-    uint8_t ov = (R[SR] & (0b1 << 3)) >> 3;
+            if((inicio & 0xFF) == 0)
+                atomic_store_explicit(&maquina->inicioFilaTrace, inicio, memory_order_release);
+        }
 
-    if(sn != ov)
-        R[PC] += i25_i << 2;
+        atomic_store_explicit(&maquina->inicioFilaTrace, inicio, memory_order_release);
+    }
 
-    // Formatação da saída
-    sprintf(instrucao, "blt %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    return argumento;
 }
+#endif
 
-void _bne()
+void inicializar_trace(Poxim *maquina)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    const char *digitos = "0123456789ABCDEF";
 
-    uint8_t zn = (R[SR] & (0b1 << 6)) >> 6;
+    maquina->bufferTrace = (char *)malloc(TAMANHO_BUFFER_TRACE * sizeof(char));
 
-    if(zn == 0)
-        R[PC] += i25_i << 2;
+    // Entradas da cache de desmontagem inicialmente inválidas
+    maquina->cacheDesmontagem = (Desmontagem *)calloc(ENTRADAS_CACHE_DESMONTAGEM, sizeof(Desmontagem));
 
-    // Formatação da saída
-    sprintf(instrucao, "bne %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    for(int byte = 0; byte < 256; byte++) {
+        maquina->tabelaHexadecimal[byte][0] = digitos[byte >> 4];
+        maquina->tabelaHexadecimal[byte][1] = digitos[byte & 0xF];
+    }
 }
 
-void _bni()
+void trace_descarregar(Poxim *maquina)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    // Sem arquivo de saída (máquina criada pela biblioteca), o trace é descartado
+    if(maquina->saida)
+        fwrite(maquina->bufferTrace, sizeof(char), maquina->tamanhoTrace, maquina->saida);
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    maquina->tamanhoTrace = 0;
+}
 
-    uint8_t iv = (R[SR] & (0b1 << 2)) >> 2;
+void trace_iniciar_linha(Poxim *maquina)
+{
+    // Nenhuma linha do trace passa de 256 caracteres: o buffer é descarregado antes de ficar sem espaço para uma
+    if(maquina->tamanhoTrace > TAMANHO_BUFFER_TRACE - 256)
+        trace_descarregar(maquina);
+}
 
-    if(iv == 0)
-        R[PC] += i25_i << 2;
+void trace_concluir_instrucao(Poxim *maquina)
+{
+    // Equivalente ao %-25s: completa com espaços, sem truncar instruções mais longas
+    while(maquina->tamanhoTrace - maquina->inicioColunaInstrucao < 25)
+        maquina->bufferTrace[maquina->tamanhoTrace++] = ' ';
 
-    // Formatação da saída
-    sprintf(instrucao, "bni %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    maquina->bufferTrace[maquina->tamanhoTrace++] = '\t';
 }
 
-void _bnz()
+void trace_caractere(Poxim *maquina, char caractere)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    maquina->bufferTrace[maquina->tamanhoTrace++] = caractere;
+}
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+void trace_texto(Poxim *maquina, const char *texto)
+{
+    while(*texto)
+        maquina->bufferTrace[maquina->tamanhoTrace++] = *texto++;
+}
 
-    uint8_t zd = (R[SR] & (0b1 << 5)) >> 5;
+void trace_hexadecimal(Poxim *maquina, uint64_t valor, int digitos)
+{
+    // Equivalente ao 0x%0*X: valores com mais dígitos que o mínimo são raros e vão para o snprintf
+    if(digitos < 16 && valor >> (digitos * 4)) {
+        maquina->tamanhoTrace += snprintf(&maquina->bufferTrace[maquina->tamanhoTrace], 32, "0x%0*lX", digitos, valor);
+        return;
+    }
 
-    if(zd == 0)
-        R[PC] += i25_i << 2;
+    maquina->bufferTrace[maquina->tamanhoTrace++] = '0';
+    maquina->bufferTrace[maquina->tamanhoTrace++] = 'x';
 
-    // Formatação da saída
-    sprintf(instrucao, "bnz %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    for(int byte = digitos / 2 - 1; byte >= 0; byte--) {
+        memcpy(&maquina->bufferTrace[maquina->tamanhoTrace], maquina->tabelaHexadecimal[(valor >> (byte * 8)) & 0xFF], 2);
+        maquina->tamanhoTrace += 2;
+    }
 }
 
-void _bun()
+void trace_decimal(Poxim *maquina, int64_t valor)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
+    char digitos[20];
+    int quantidade = 0;
+    uint64_t absoluto = valor < 0 ? -(uint64_t)valor : (uint64_t)valor;
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    if(valor < 0)
+        maquina->bufferTrace[maquina->tamanhoTrace++] = '-';
 
-    R[PC] = R[PC] + (i25_i << 2);
+    do {
+        digitos[quantidade++] = '0' + absoluto % 10;
+        absoluto /= 10;
+    } while(absoluto);
 
-    // Formatação da saída
-    sprintf(instrucao, "bun %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+    while(quantidade)
+        maquina->bufferTrace[maquina->tamanhoTrace++] = digitos[--quantidade];
 }
 
-void _bzd()
+void trace_registrador(Poxim *maquina, uint8_t indice)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
-
-    uint8_t zd = (R[SR] & (0b1 << 5)) >> 5;
-
-    if(zd)
-        R[PC] += i25_i << 2;
+    trace_texto(maquina, NOMES_REGISTRADORES[indice]);
+}
 
-    // Formatação da saída
-    sprintf(instrucao, "bzd %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X\n", pcAtual, instrucao, R[PC] + 4);
+void trace_registrador_maiusculo(Poxim *maquina, uint8_t indice)
+{
+    trace_texto(maquina, NOMES_REGISTRADORES_MAIUSCULOS[indice]);
 }
 
-void _calls()
+void trace_endereco_relativo(Poxim *maquina, uint8_t x, int32_t i)
 {
-    int32_t i = R[IR] & 0x3ffffff;
-    uint8_t i25 = i >> 25;
-    int32_t i25_i = i;
-    uint32_t spAtual = R[SP];
+    trace_caractere(maquina, '[');
+    trace_registrador(maquina, x);
 
-    if(i25 == 1)
-        i25_i = i | 0xfc000000;
+    if(i >= 0)
+        trace_caractere(maquina, '+');
 
-    MEM[R[SP] >> 2] = R[PC] + 4;
-    R[SP] -= 4;
-    R[PC] += (i25_i << 2);
+    trace_decimal(maquina, i);
+    trace_caractere(maquina, ']');
+}
 
-    // Formatação da saída
-    sprintf(instrucao, "call %d", i25_i);
-    fprintf(saida, "0x%08X:\t%-25s\tPC=0x%08X,MEM[0x%08X]=0x%08X\n", pcAtual, instrucao, R[PC] + 4, spAtual, pcAtual + 4);
+void trace_sr(Poxim *maquina, uint32_t sr)
+{
+    trace_texto(maquina, ",SR=");
+    trace_hexadecimal(maquina, sr, 8);
 }
 
-void _int()
+uint8_t listar_registradores_pilha(InstrucaoDecodificada *decodificada, uint8_t *registradores)
 {
-    uint32_t i = R[IR] & 0x3ffffff;
+    // Registradores na ordem de empilhamento (v, w, x, y, z), encerrada no primeiro R0
+    uint8_t campos[5] = {decodificada->v, decodificada->l, decodificada->x, decodificada->y, decodificada->z};
+    uint8_t registradoresValidos = 0;
 
-    if(!i) {
-        emExecucao = 0;
-    } else {
-        preparar_execucao_ISR();
-        R[CR] = i;
-        R[IPC] = R[PC];
-        R[PC] = 0x0000000C;
-        R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    while(registradoresValidos < 5 && campos[registradoresValidos]) {
+        registradores[registradoresValidos] = campos[registradoresValidos];
+        registradoresValidos++;
     }
 
-    // Formatação da saída
-    sprintf(instrucao, "int %u", i);
-    fprintf(saida, "0x%08X:\t%-25s\tCR=0x%08X,PC=0x%08X\n", pcAtual, instrucao, i ? R[CR] : 0, i ? R[PC] + 4 : 0);
-
-    if(i) fprintf(saida, "[SOFTWARE INTERRUPTION]\n");
+    return registradoresValidos;
 }
 
-uint8_t empilhar(uint8_t i)
+void emitir_passo(Poxim *maquina, PassoTrace *passo)
 {
-    if(i != 0) {
-        MEM[R[SP] >> 2] = R[i];
-        R[SP] -= 4;
+#ifdef TRACE_ASSINCRONO
+    uint32_t fim = atomic_load_explicit(&maquina->fimFilaTrace, memory_order_relaxed);
 
-        return 1;
+    // Fila cheia: o interpretador espera a thread do trace liberar espaço
+    while(fim - maquina->inicioFilaProdutor == CAPACIDADE_FILA_TRACE) {
+        maquina->inicioFilaProdutor = atomic_load_explicit(&maquina->inicioFilaTrace, memory_order_acquire);
+
+        if(fim - maquina->inicioFilaProdutor == CAPACIDADE_FILA_TRACE)
+            sched_yield();
     }
 
-    return 0;
+    maquina->filaTrace[fim & (CAPACIDADE_FILA_TRACE - 1)] = *passo;
+    atomic_store_explicit(&maquina->fimFilaTrace, fim + 1, memory_order_release);
+#else
+    escrever_passo(maquina, passo);
+#endif
 }
 
-uint8_t desempilhar(uint8_t i)
+void escrever_passo(Poxim *maquina, PassoTrace *passo)
 {
-    if(i != 0) {
-        R[SP] += 4;
-        R[i] = MEM[R[SP] >> 2];
+    trace_iniciar_linha(maquina);
 
-        return 1;
+    // No trace binário o registro é copiado como está; no texto, é renderizado imediatamente
+    if(maquina->traceBinario) {
+        memcpy(&maquina->bufferTrace[maquina->tamanhoTrace], passo, sizeof(PassoTrace));
+        maquina->tamanhoTrace += sizeof(PassoTrace);
+        maquina->registrosTrace++;
+    } else {
+        renderizar_passo(maquina, passo);
     }
-
-    return 0;
 }
 
-void formatar_string_registrador(uint8_t indice, char *stringRegistrador)
+void renderizar_passo(Poxim *maquina, PassoTrace *passo)
 {
-    switch(indice) {
-        case CR:
-            sprintf(stringRegistrador, "cr");
-            break;
-        case IPC:
-            sprintf(stringRegistrador, "ipc");
+    switch(passo->tipo) {
+        case PASSO_INSTRUCAO:
+            renderizar_instrucao(maquina, passo);
             break;
-        case IR:
-            sprintf(stringRegistrador, "ir");
+        case PASSO_INSTRUCAO_INVALIDA:
+            trace_texto(maquina, "[INVALID INSTRUCTION @ ");
+            trace_hexadecimal(maquina, passo->pc, 8);
+            trace_texto(maquina, "]\n");
             break;
-        case PC:
-            sprintf(stringRegistrador, "pc");
+        case PASSO_INTERRUPCAO_SOFTWARE:
+            trace_texto(maquina, "[SOFTWARE INTERRUPTION]\n");
             break;
-        case SP:
-            sprintf(stringRegistrador, "sp");
+        case PASSO_INTERRUPCAO_HARDWARE:
+            trace_texto(maquina, "[HARDWARE INTERRUPTION ");
+            trace_decimal(maquina, passo->valores[0]);
+            trace_texto(maquina, "]\n");
             break;
-        case SR:
-            sprintf(stringRegistrador, "sr");
-            break;
-        default:
-            sprintf(stringRegistrador, "r%u", indice);
     }
 }
 
-void formatar_string_empilhamento_instrucao(char *string, uint8_t rValidos, char *stringRegistrador)
+void renderizar_instrucao(Poxim *maquina, PassoTrace *passo)
 {
-    if(rValidos && stringRegistrador != NULL) {
-        if(rValidos > 1)
-            string = strcat(string, ",");
+    // Apenas a coluna de valores é formatada a cada execução
+    Desmontagem *desmontagem = obter_desmontagem(maquina, passo->pc, passo->ir);
 
-        string = strcat(string, stringRegistrador);
-    } else {
-        string = strcat(string, "-");
-    }
+    renderizar_valores(maquina, &desmontagem->decodificada, passo);
+    trace_caractere(maquina, '\n');
 }
 
-void formatar_string_empilhamento_resultado_pt1(char *string, uint8_t rValidos, uint32_t valor)
+Desmontagem *obter_desmontagem(Poxim *maquina, uint32_t pc, uint32_t ir)
 {
-    char hexa[15] = {0};
+    Desmontagem *desmontagem = &maquina->desmontagemAvulsa;
 
-    sprintf(hexa, "0x%08X", valor);
+    if((pc >> 2) < ENTRADAS_CACHE_DESMONTAGEM)
+        desmontagem = &maquina->cacheDesmontagem[pc >> 2];
 
-    if(rValidos > 1)
-        string = strcat(string, ",");
+    // Início de linha já formatado: copiado direto para o buffer
+    if(desmontagem->valida && desmontagem->pc == pc && desmontagem->ir == ir) {
+        memcpy(&maquina->bufferTrace[maquina->tamanhoTrace], desmontagem->texto, desmontagem->tamanho);
+        maquina->tamanhoTrace += desmontagem->tamanho;
 
-    string = strcat(string, hexa);
-}
+        return desmontagem;
+    }
 
-void formatar_string_empilhamento_resultado_pt2(char *string, uint8_t rValidos, char *stringRegistrador)
-{
-    if(rValidos > 1)
-        string = strcat(string, ",");
+    int inicio = maquina->tamanhoTrace;
 
-    string = strcat(string, str_upper(stringRegistrador));
-}
+    // Os campos da instrução são recuperados do IR registrado, com o mesmo decodificador da execução
+    decodificar_palavra(&desmontagem->decodificada, ir, pc);
 
-void inicializar_simulador()
-{
-    // 32KiB de memória inicializados com 0
-    MEM = (uint32_t *)calloc(32, 1024);
+    trace_hexadecimal(maquina, pc, 8);
+    trace_caractere(maquina, ':');
+    trace_caractere(maquina, '\t');
 
-    // Adicionando as instruções na memória
-    uint32_t instrucao, i = 0;
-    while(fscanf(entrada, "%X", &instrucao) != EOF)
-        MEM[i++] = instrucao;
+    maquina->inicioColunaInstrucao = maquina->tamanhoTrace;
 
-    // Alocando memória para o output do terminal
-    outputTerminal = (char *)malloc(TAMANHO_BASE_OUTPUT * sizeof(char));
+    desmontar_instrucao(maquina, &desmontagem->decodificada);
+    trace_concluir_instrucao(maquina);
+
+    // A instrução mais longa ("push r25,r25,r25,r25,r25") ainda cabe na coluna de 25 caracteres
+    desmontagem->pc = pc;
+    desmontagem->ir = ir;
+    desmontagem->tamanho = maquina->tamanhoTrace - inicio;
+    desmontagem->valida = desmontagem != &maquina->desmontagemAvulsa;
+    memcpy(desmontagem->texto, &maquina->bufferTrace[inicio], desmontagem->tamanho);
 
-    // Inserindo mensagem de início de execução no arquivo de output
-    fprintf(saida, "[START OF SIMULATION]\n");
+    return desmontagem;
 }
 
-void finalizar_simulador()
+void desmontar_instrucao(Poxim *maquina, InstrucaoDecodificada *decodificada)
 {
-    if(tamanhoOutput)
-        imprimir_output_terminal();
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l = decodificada->l;
+    int32_t imediato = decodificada->imediato;
+    uint8_t registradores[5];
+    uint8_t registradoresValidos;
+
+    trace_texto(maquina, MNEMONICOS[decodificada->operacao]);
+
+    switch(decodificada->operacao) {
+        case OP_MOV:
+        case OP_MOVS:
+            // Exibe o valor de R[z] após a escrita, que continua 0 quando z é R0
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_decimal(maquina, z ? imediato : 0);
+            break;
+        case OP_ADD:
+        case OP_SUB:
+        case OP_AND:
+        case OP_OR:
+        case OP_XOR:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, x);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, y);
+            break;
+        case OP_MUL:
+        case OP_MULS:
+        case OP_DIV:
+        case OP_DIVS:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, l);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, x);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, y);
+            break;
+        case OP_SLL:
+        case OP_SLA:
+        case OP_SRL:
+        case OP_SRA:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, x);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, y);
+            trace_caractere(maquina, ',');
+            trace_decimal(maquina, l);
+            break;
+        case OP_CMP:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, x);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, y);
+            break;
+        case OP_NOT:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, x);
+            break;
+        case OP_PUSH:
+        case OP_POP:
+            registradoresValidos = listar_registradores_pilha(decodificada, registradores);
 
-    // Inserindo mensagem de final de execução no arquivo de output
-    fprintf(saida, "[END OF SIMULATION]\n");
+            trace_caractere(maquina, ' ');
 
-    // Fechando arquivos de entrada e saída
-    fclose(entrada);
-    fclose(saida);
+            for(uint8_t i = 0; i < registradoresValidos; i++) {
+                if(i)
+                    trace_caractere(maquina, ',');
+                trace_registrador(maquina, registradores[i]);
+            }
+
+            if(registradoresValidos == 0)
+                trace_caractere(maquina, '-');
+            break;
+        case OP_ADDI:
+        case OP_SUBI:
+        case OP_MULI:
+        case OP_DIVI:
+        case OP_MODI:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, x);
+            trace_caractere(maquina, ',');
+            trace_decimal(maquina, imediato);
+            break;
+        case OP_CMPI:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, x);
+            trace_caractere(maquina, ',');
+            trace_decimal(maquina, imediato);
+            break;
+        case OP_L8:
+        case OP_L16:
+        case OP_L32:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ',');
+            trace_endereco_relativo(maquina, x, imediato);
+            break;
+        case OP_S8:
+        case OP_S16:
+        case OP_S32:
+            trace_caractere(maquina, ' ');
+            trace_endereco_relativo(maquina, x, imediato);
+            trace_caractere(maquina, ',');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, ' ');
+            break;
+        case OP_CALLF:
+            trace_caractere(maquina, ' ');
+            trace_endereco_relativo(maquina, x, imediato);
+            break;
+        case OP_RET:
+        case OP_RETI:
+        case OP_INVALIDA:
+            break;
+        case OP_CBR:
+        case OP_SBR:
+            trace_caractere(maquina, ' ');
+            trace_registrador(maquina, z);
+            trace_caractere(maquina, '[');
+            trace_decimal(maquina, x);
+            trace_caractere(maquina, ']');
+            break;
+        default:
+            // Desvios, call do tipo S e int: apenas o imediato
+            trace_caractere(maquina, ' ');
+            trace_decimal(maquina, imediato);
+    }
+}
+
+void renderizar_valores(Poxim *maquina, InstrucaoDecodificada *decodificada, PassoTrace *passo)
+{
+    uint8_t z = decodificada->z;
+    uint8_t x = decodificada->x;
+    uint8_t y = decodificada->y;
+    uint8_t l = decodificada->l;
+    uint32_t *valores = passo->valores;
+    uint8_t registradores[5];
+    uint8_t registradoresValidos;
+
+    switch(decodificada->operacao) {
+        case OP_MOV:
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, (uint32_t)decodificada->imediato, 8);
+            break;
+        case OP_MOVS:
+        case OP_CBR:
+        case OP_SBR:
+            // R[z]
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, valores[0], 8);
+            break;
+        case OP_ADD:
+        case OP_SUB:
+        case OP_AND:
+        case OP_OR:
+        case OP_XOR:
+            // R[z], SR
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, OPERADORES[decodificada->operacao]);
+            trace_registrador_maiusculo(maquina, y);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_sr(maquina, valores[1]);
+            break;
+        case OP_NOT:
+            // R[z], SR
+            trace_registrador_maiusculo(maquina, z);
+            trace_texto(maquina, "=~");
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_sr(maquina, valores[1]);
+            break;
+        case OP_ADDI:
+        case OP_SUBI:
+        case OP_MULI:
+        case OP_DIVI:
+        case OP_MODI:
+            // R[z], SR
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, OPERADORES[decodificada->operacao]);
+            trace_hexadecimal(maquina, (uint32_t)decodificada->imediato, 8);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_sr(maquina, valores[1]);
+            break;
+        case OP_MUL:
+        case OP_MULS:
+            // R[l], R[z], SR
+            trace_registrador_maiusculo(maquina, l);
+            trace_caractere(maquina, ':');
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, '*');
+            trace_registrador_maiusculo(maquina, y);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, (((uint64_t)valores[0]) << 32) | valores[1], 16);
+            trace_sr(maquina, valores[2]);
+            break;
+        case OP_DIV:
+        case OP_DIVS:
+            // R[l], R[z], SR
+            trace_registrador_maiusculo(maquina, l);
+            trace_caractere(maquina, '=');
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, '%');
+            trace_registrador_maiusculo(maquina, y);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_caractere(maquina, ',');
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, '/');
+            trace_registrador_maiusculo(maquina, y);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, valores[1], 8);
+            trace_sr(maquina, valores[2]);
+            break;
+        case OP_SLL:
+        case OP_SLA:
+        case OP_SRL:
+        case OP_SRA:
+            // R[z], R[x], SR
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, ':');
+            trace_registrador_maiusculo(maquina, x);
+            trace_caractere(maquina, '=');
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, ':');
+            trace_registrador_maiusculo(maquina, y);
+            trace_texto(maquina, decodificada->operacao == OP_SLL || decodificada->operacao == OP_SLA ? "<<" : ">>");
+            trace_decimal(maquina, l + 1);
+            trace_caractere(maquina, '=');
+            trace_hexadecimal(maquina, (((uint64_t)valores[0]) << 32) | valores[1], 16);
+            trace_sr(maquina, valores[2]);
+            break;
+        case OP_CMP:
+        case OP_CMPI:
+            // SR
+            trace_texto(maquina, "SR=");
+            trace_hexadecimal(maquina, valores[0], 8);
+            break;
+        case OP_L8:
+        case OP_L16:
+        case OP_L32:
+            // Endereço, R[z]
+            trace_registrador_maiusculo(maquina, z);
+            trace_texto(maquina, "=MEM[");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, "]=");
+            trace_hexadecimal(maquina, valores[1], decodificada->operacao == OP_L8 ? 2 : decodificada->operacao == OP_L16 ? 4 : 8);
+            break;
+        case OP_S8:
+        case OP_S16:
+        case OP_S32:
+            // Endereço, R[z]
+            trace_texto(maquina, "MEM[");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, "]=");
+            trace_registrador_maiusculo(maquina, z);
+            trace_caractere(maquina, '=');
+
+            if(decodificada->operacao == OP_S8)
+                trace_hexadecimal(maquina, (uint8_t)valores[1], 2);
+            else
+                trace_hexadecimal(maquina, valores[1], decodificada->operacao == OP_S16 ? 4 : 8);
+            break;
+        case OP_PUSH:
+            // SP inicial, valores empilhados
+            registradoresValidos = listar_registradores_pilha(decodificada, registradores);
+
+            trace_texto(maquina, "MEM[");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, "]{");
+
+            for(uint8_t i = 0; i < registradoresValidos; i++) {
+                if(i)
+                    trace_caractere(maquina, ',');
+                trace_hexadecimal(maquina, valores[i + 1], 8);
+            }
 
-    // Fechando arquivo de debug
-    fclose(debug);
+            trace_texto(maquina, "}={");
 
-    // Liberando memória alocada para o array de memória
-    free(MEM);
+            for(uint8_t i = 0; i < registradoresValidos; i++) {
+                if(i)
+                    trace_caractere(maquina, ',');
+                trace_registrador_maiusculo(maquina, registradores[i]);
+            }
 
-    // Liberando memória alocada para o output do terminal
-    free(outputTerminal);
+            trace_caractere(maquina, '}');
+            break;
+        case OP_POP:
+            // SP inicial, valores desempilhados
+            registradoresValidos = listar_registradores_pilha(decodificada, registradores);
 
-    // Liberando memória alocada para armazenar as interrupções mascaráveis que ficaram pendentes
-    destruir_interrupcoes_agendadas();
-}
+            trace_caractere(maquina, '{');
 
-void imprimir_output_terminal()
-{
-    outputTerminal[tamanhoOutput + 1] = '\0';
+            for(uint8_t i = 0; i < registradoresValidos; i++) {
+                if(i)
+                    trace_caractere(maquina, ',');
+                trace_registrador_maiusculo(maquina, registradores[i]);
+            }
 
-    fprintf(saida, "[TERMINAL]\n");
-    fprintf(saida, "%s", outputTerminal);
-    fprintf(saida, "\n");
-}
+            trace_texto(maquina, "}=MEM[");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, "]{");
 
-void adicionar_caractere_output(char caractere)
-{
-    outputTerminal[tamanhoOutput++] = caractere;
+            for(uint8_t i = 0; i < registradoresValidos; i++) {
+                if(i)
+                    trace_caractere(maquina, ',');
+                trace_hexadecimal(maquina, valores[i + 1], 8);
+            }
 
-    if(tamanhoOutput && tamanhoOutput % TAMANHO_BASE_OUTPUT == 0) {
-        int novoTamanho = (tamanhoOutput + TAMANHO_BASE_OUTPUT) * sizeof(char);
-        outputTerminal = (char *)realloc(outputTerminal, novoTamanho);
+            trace_caractere(maquina, '}');
+            break;
+        case OP_CALLF:
+        case OP_CALLS:
+            // Novo PC, SP inicial
+            trace_texto(maquina, "PC=");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, ",MEM[");
+            trace_hexadecimal(maquina, valores[1], 8);
+            trace_texto(maquina, "]=");
+            trace_hexadecimal(maquina, passo->pc + 4, 8);
+            break;
+        case OP_RET:
+            // SP, novo PC
+            trace_texto(maquina, "PC=MEM[");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, "]=");
+            trace_hexadecimal(maquina, valores[1], 8);
+            break;
+        case OP_RETI:
+            // Endereços e valores de IPC, CR e PC restaurados da pilha
+            trace_texto(maquina, "IPC=MEM[");
+            trace_hexadecimal(maquina, valores[0], 8);
+            trace_texto(maquina, "]=");
+            trace_hexadecimal(maquina, valores[1], 8);
+            trace_texto(maquina, ",CR=MEM[");
+            trace_hexadecimal(maquina, valores[2], 8);
+            trace_texto(maquina, "]=");
+            trace_hexadecimal(maquina, valores[3], 8);
+            trace_texto(maquina, ",PC=MEM[");
+            trace_hexadecimal(maquina, valores[4], 8);
+            trace_texto(maquina, "]=");
+            trace_hexadecimal(maquina, valores[5], 8);
+            break;
+        case OP_INT:
+            // CR, novo PC (exibidos como 0 no int 0, que encerra a execução)
+            trace_texto(maquina, "CR=");
+            trace_hexadecimal(maquina, decodificada->imediato ? valores[0] : 0, 8);
+            trace_texto(maquina, ",PC=");
+            trace_hexadecimal(maquina, decodificada->imediato ? valores[1] : 0, 8);
+            break;
+        default:
+            // Desvios: novo PC
+            trace_texto(maquina, "PC=");
+            trace_hexadecimal(maquina, valores[0], 8);
     }
 }
 
-void retornar_instrucao_invalida()
+void retornar_instrucao_invalida(Poxim *maquina, InstrucaoDecodificada *decodificada)
 {
-    uint8_t ir31_26 = (R[IR] & (0b111111 << 26)) >> 26;
+    uint8_t ir31_26 = (decodificada->ir & (0b111111 << 26)) >> 26;
     // Exibindo mensagem de erro
-    fprintf(saida, "[INVALID INSTRUCTION @ 0x%08X]\n", R[PC]);
-    fprintf(saida, "[SOFTWARE INTERRUPTION]\n");
-    preparar_execucao_ISR();
-
-    ativar_flag(IV);
-    R[CR] = ir31_26;
-    R[IPC] = R[PC];
-    R[PC] = 0x00000004;
-    R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    registrar_instrucao_invalida(maquina, maquina->R[PC]);
+    registrar_interrupcao_software(maquina);
+    preparar_execucao_ISR(maquina);
+
+    ativar_flag(maquina, IV);
+    maquina->R[CR] = ir31_26;
+    maquina->R[IPC] = maquina->R[PC];
+    maquina->R[PC] = 0x00000004;
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
 }
 
-void ativar_flag(Flag flag)
+void ativar_flag(Poxim *maquina, Flag flag)
 {
-    R[SR] = R[SR] | (0b1 << flag);
-}
+    // As flags pendentes são escritas antes, para não sobrescreverem esta depois
+    materializar_flags(maquina);
 
-void desativar_flag(Flag flag)
-{
-    R[SR] = R[SR] & ~(0b1 << flag);
+    maquina->R[SR] = maquina->R[SR] | (0b1 << flag);
 }
 
-uint8_t verificar_flag_setada(Flag flag)
+void desativar_flag(Poxim *maquina, Flag flag)
 {
-    return (R[SR] & (0b1 << flag)) >> flag;
+    materializar_flags(maquina);
+
+    maquina->R[SR] = maquina->R[SR] & ~(0b1 << flag);
 }
 
-void preparar_execucao_ISR()
+uint8_t verificar_flag_setada(Poxim *maquina, Flag flag)
 {
-    MEM[R[SP] >> 2] = R[PC] + 4;
-    R[SP] -= 4;
-
-    MEM[R[SP] >> 2] = R[CR];
-    R[SP] -= 4;
+    if(FLAGS_AFETADAS[maquina->flagsPendentes.operacao] & (0b1 << flag))
+        materializar_flags(maquina);
 
-    MEM[R[SP] >> 2] = R[IPC];
-    R[SP] -= 4;
+    return (maquina->R[SR] & (0b1 << flag)) >> flag;
 }
 
-Interrupcao *obter_interrupcao_duplicada(Interrupcao *interrupcao)
+void registrar_flags(Poxim *maquina, OperacaoFlags operacao, uint8_t z, uint8_t x, uint8_t y, uint8_t l, int32_t imediato)
 {
-    Interrupcao *atual = interrupcoesAgendadas;
-
-    while(atual) {
-        if(atual->cr == interrupcao->cr && atual->prioridade == interrupcao->prioridade)
-            return atual;
+    // Flags pendentes que a nova operação não reescreve precisam chegar ao SR antes de serem descartadas
+    if(FLAGS_AFETADAS[maquina->flagsPendentes.operacao] & ~FLAGS_AFETADAS[operacao])
+        materializar_flags(maquina);
+
+    maquina->flagsPendentes.operacao = operacao;
+    maquina->flagsPendentes.z = z;
+    maquina->flagsPendentes.x = x;
+    maquina->flagsPendentes.y = y;
+    maquina->flagsPendentes.l = l;
+    maquina->flagsPendentes.rz = maquina->R[z];
+    maquina->flagsPendentes.rx = maquina->R[x];
+    maquina->flagsPendentes.ry = maquina->R[y];
+    maquina->flagsPendentes.rl = maquina->R[l];
+    maquina->flagsPendentes.imediato = imediato;
+
+    // Com o SR como operando, cada flag escrita altera os operandos das seguintes: calcula tudo agora
+    if(z == SR || x == SR || y == SR || l == SR)
+        materializar_flags(maquina);
+}
 
-        atual = atual->prox;
-    }
+uint32_t operando_flags(Poxim *maquina, uint8_t indice, uint32_t valor)
+{
+    // O SR é relido a cada uso, como no cálculo imediato das flags; os demais valem o que valiam na execução
+    if(indice == SR)
+        return maquina->R[SR];
 
-    return NULL;
+    return valor;
 }
 
-void remover_interrupcao_agendada(Interrupcao *interrupcao)
+void atribuir_flag(Poxim *maquina, Flag flag, uint8_t valor)
 {
-    if(interrupcao->ant)
-        interrupcao->ant->prox = interrupcao->prox;
+    if(valor)
+        maquina->R[SR] = maquina->R[SR] | (0b1 << flag);
     else
-        interrupcoesAgendadas = interrupcao->prox;
-
-    if(interrupcao->prox)
-        interrupcao->prox->ant = interrupcao->ant;
-
-    free(interrupcao);
+        maquina->R[SR] = maquina->R[SR] & ~(0b1 << flag);
 }
 
-void agendar_interrupcao(uint8_t prioridade, uint32_t cr, uint32_t ipc)
+void materializar_flags(Poxim *maquina)
 {
-    Interrupcao *novaInterrupcao = (Interrupcao *)malloc(sizeof(Interrupcao));
-    Interrupcao *atual = interrupcoesAgendadas;
-
-    novaInterrupcao->prioridade = prioridade;
-    novaInterrupcao->cr = cr;
-    novaInterrupcao->ipc = ipc;
-    novaInterrupcao->ant = NULL;
-    novaInterrupcao->prox = NULL;
-
-    if(obter_interrupcao_duplicada(novaInterrupcao))
-        remover_interrupcao_agendada(obter_interrupcao_duplicada(novaInterrupcao));
-
-    if(atual == NULL) {
-        interrupcoesAgendadas = novaInterrupcao;
-        return;
-    }
-
-    while(novaInterrupcao->prioridade > atual->prioridade) {
-        if(atual->prox == NULL) {
-            atual->prox = novaInterrupcao;
-            novaInterrupcao->ant = atual;
+    FlagsPendentes *f = &maquina->flagsPendentes;
+    uint32_t rz, rx, ry, rl;
+    uint8_t rz31, rx31, ry31;
+    uint8_t i15 = (int16_t)f->imediato >> 15;
+    uint64_t cmp;
+    int64_t cmpi;
 
+    switch(f->operacao) {
+        case FLAGS_MATERIALIZADAS:
             return;
-        }
-
-        atual = atual->prox;
+        case FLAGS_ADD:
+        case FLAGS_SUB:
+            atribuir_flag(maquina, ZN, operando_flags(maquina, f->z, f->rz) == 0);
+
+            rz31 = (operando_flags(maquina, f->z, f->rz) & 0x80000000) >> 31;
+            atribuir_flag(maquina, SN, rz31 == 1);
+
+            rx31 = (operando_flags(maquina, f->x, f->rx) & 0x80000000) >> 31;
+            ry31 = (operando_flags(maquina, f->y, f->ry) & 0x80000000) >> 31;
+
+            if(f->operacao == FLAGS_ADD) {
+                atribuir_flag(maquina, OV, rx31 == ry31 && rz31 != rx31);
+                rx = operando_flags(maquina, f->x, f->rx);
+                ry = operando_flags(maquina, f->y, f->ry);
+                atribuir_flag(maquina, CY, (((uint64_t)rx + (uint64_t)ry) >> 32) & 0b1);
+            } else {
+                atribuir_flag(maquina, OV, rx31 != ry31 && rz31 != rx31);
+                rx = operando_flags(maquina, f->x, f->rx);
+                ry = operando_flags(maquina, f->y, f->ry);
+                atribuir_flag(maquina, CY, (((uint64_t)rx - (uint64_t)ry) >> 32) & 0b1);
+            }
+            break;
+        case FLAGS_ADDI:
+        case FLAGS_SUBI:
+            atribuir_flag(maquina, ZN, operando_flags(maquina, f->z, f->rz) == 0);
+
+            rz31 = (operando_flags(maquina, f->z, f->rz) & 0x80000000) >> 31;
+            atribuir_flag(maquina, SN, rz31 == 1);
+
+            rx31 = (operando_flags(maquina, f->x, f->rx) & 0x80000000) >> 31;
+
+            if(f->operacao == FLAGS_ADDI) {
+                atribuir_flag(maquina, OV, rx31 == i15 && rz31 != rx31);
+                rx = operando_flags(maquina, f->x, f->rx);
+                atribuir_flag(maquina, CY, (((uint64_t)rx + (uint64_t)f->imediato) >> 32) == 1);
+            } else {
+                atribuir_flag(maquina, OV, rx31 != i15 && rz31 != rx31);
+                rx = operando_flags(maquina, f->x, f->rx);
+                atribuir_flag(maquina, CY, (((uint64_t)rx - (uint64_t)f->imediato) >> 32) == 1);
+            }
+            break;
+        case FLAGS_CMP:
+            // A diferença é calculada antes de qualquer flag ser escrita
+            cmp = (uint64_t)operando_flags(maquina, f->x, f->rx) - (uint64_t)operando_flags(maquina, f->y, f->ry);
+            atribuir_flag(maquina, ZN, cmp == 0);
+            atribuir_flag(maquina, SN, (cmp & 0x80000000) >> 31);
+
+            rx31 = (operando_flags(maquina, f->x, f->rx) & 0x80000000) >> 31;
+            ry31 = (operando_flags(maquina, f->y, f->ry) & 0x80000000) >> 31;
+            atribuir_flag(maquina, OV, rx31 != ry31 && ((cmp & 0x80000000) >> 31) != rx31);
+            atribuir_flag(maquina, CY, (cmp >> 32) & 0b1);
+            break;
+        case FLAGS_CMPI:
+            // Subtração de 32 bits com sinal, estendida para 64 bits
+            cmpi = (int32_t)(operando_flags(maquina, f->x, f->rx) - (uint32_t)f->imediato);
+            atribuir_flag(maquina, ZN, cmpi == 0);
+            atribuir_flag(maquina, SN, (cmpi & 0x80000000) >> 31);
+
+            rx31 = (operando_flags(maquina, f->x, f->rx) & 0x80000000) >> 31;
+            atribuir_flag(maquina, OV, rx31 != i15 && ((cmpi & 0x80000000) >> 31) != rx31);
+            atribuir_flag(maquina, CY, (cmpi & 0x100000000) >> 32);
+            break;
+        case FLAGS_LOGICA:
+            atribuir_flag(maquina, ZN, operando_flags(maquina, f->z, f->rz) == 0);
+            atribuir_flag(maquina, SN, (operando_flags(maquina, f->z, f->rz) & 0x80000000) >> 31);
+            break;
+        case FLAGS_MUL:
+        case FLAGS_MULS:
+            rl = operando_flags(maquina, f->l, f->rl);
+            rz = operando_flags(maquina, f->z, f->rz);
+            atribuir_flag(maquina, ZN, ((((uint64_t)rl) << 32) | rz) == 0);
+
+            rl = operando_flags(maquina, f->l, f->rl);
+            atribuir_flag(maquina, f->operacao == FLAGS_MUL ? CY : OV, rl != 0);
+            break;
+        case FLAGS_MULI:
+            atribuir_flag(maquina, ZN, operando_flags(maquina, f->z, f->rz) == 0);
 
+            // Produto de 32 bits com sinal: os 32 bits superiores da extensão só são não nulos se ele for negativo
+            rx = operando_flags(maquina, f->x, f->rx);
+            atribuir_flag(maquina, OV, (int32_t)(rx * (uint32_t)f->imediato) < 0);
+            break;
+        case FLAGS_DESLOCAMENTO:
+        case FLAGS_DESLOCAMENTO_ARITMETICO:
+            rz = operando_flags(maquina, f->z, f->rz);
+            rx = operando_flags(maquina, f->x, f->rx);
+            atribuir_flag(maquina, ZN, ((((uint64_t)rz) << 32) | rx) == 0);
+
+            rz = operando_flags(maquina, f->z, f->rz);
+            atribuir_flag(maquina, f->operacao == FLAGS_DESLOCAMENTO ? CY : OV, rz != 0);
+            break;
     }
 
-    if(atual->ant)
-        atual->ant->prox = novaInterrupcao;
-
-    atual->ant = novaInterrupcao;
-    novaInterrupcao->ant = atual->ant;
-    novaInterrupcao->prox = atual;
+    f->operacao = FLAGS_MATERIALIZADAS;
 }
 
-void tratar_interrupcao()
+void preparar_execucao_ISR(Poxim *maquina)
 {
-    R[CR] = interrupcoesAgendadas->cr;
-    R[IPC] = interrupcoesAgendadas->ipc;
+    // A rotina de tratamento observa o SR com as flags já calculadas
+    materializar_flags(maquina);
 
-    switch(interrupcoesAgendadas->prioridade) {
-        case 1: R[PC] = 0x10; break;
-        case 2: 
-            R[PC] = 0x14; // Seta o campo de status pra 1
-            fpuControle = fpuControle | (0b1 << 5);
-            break;
-        case 3: R[PC] = 0x18; break;
-        case 4: R[PC] = 0x1C; break;
-    }
+    maquina->MEM[maquina->R[SP] >> 2] = maquina->R[PC] + 4;
+    invalidar_instrucao_decodificada(maquina, maquina->R[SP] >> 2);
+    maquina->R[SP] -= 4;
 
-    if(interrupcoesAgendadas->prioridade > 1) {
-        // Resetando a operação do registrador do FPU
-        fpuControle = fpuControle & (0b1 << 5);
-    }
+    maquina->MEM[maquina->R[SP] >> 2] = maquina->R[CR];
+    invalidar_instrucao_decodificada(maquina, maquina->R[SP] >> 2);
+    maquina->R[SP] -= 4;
 
-    R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    maquina->MEM[maquina->R[SP] >> 2] = maquina->R[IPC];
+    invalidar_instrucao_decodificada(maquina, maquina->R[SP] >> 2);
+    maquina->R[SP] -= 4;
+}
 
-    fprintf(saida, "[HARDWARE INTERRUPTION %u]\n", interrupcoesAgendadas->prioridade);
+void agendar_interrupcao(Poxim *maquina, uint8_t prioridade, uint32_t cr, uint32_t ipc)
+{
+    // Uma interrupção já pendente com a mesma prioridade (e portanto o mesmo CR) é substituída
+    maquina->tabelaInterrupcoes[prioridade].cr = cr;
+    maquina->tabelaInterrupcoes[prioridade].ipc = ipc;
+    maquina->interrupcoesAgendadas |= 0b1 << prioridade;
 
-    remover_interrupcao_agendada(interrupcoesAgendadas);
+    // Verificada a partir da instrução seguinte, já que a verificação desta é a primeira do seu fim
+    agendar_evento(maquina, EVENTO_INTERRUPCOES, maquina->instrucoesExecutadas + 1);
 }
 
-void destruir_interrupcoes_agendadas()
+void tratar_interrupcao(Poxim *maquina)
 {
-    Interrupcao *ultimo = interrupcoesAgendadas;
-    Interrupcao *anterior;
+    // Prioridade pendente de menor número: primeiro bit ligado do mapa
+    uint8_t prioridade = ffs(maquina->interrupcoesAgendadas) - 1;
 
-    if(ultimo == NULL)
-        return;
+    maquina->R[CR] = maquina->tabelaInterrupcoes[prioridade].cr;
+    maquina->R[IPC] = maquina->tabelaInterrupcoes[prioridade].ipc;
 
-    while(ultimo->prox)
-        ultimo = ultimo->prox;
+    switch(prioridade) {
+        case 1: maquina->R[PC] = 0x10; break;
+        case 2: 
+            maquina->R[PC] = 0x14; // Seta o campo de status pra 1
+            maquina->fpuControle = maquina->fpuControle | (0b1 << 5);
+            break;
+        case 3: maquina->R[PC] = 0x18; break;
+        case 4: maquina->R[PC] = 0x1C; break;
+    }
 
-    anterior = ultimo->ant;
+    if(prioridade > 1) {
+        // Resetando a operação do registrador do FPU
+        maquina->fpuControle = maquina->fpuControle & (0b1 << 5);
+    }
 
-    while(ultimo) {
-        free(ultimo);
+    maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
 
-        ultimo = anterior;
+    registrar_interrupcao_hardware(maquina, prioridade);
 
-        if(anterior)
-            anterior = anterior->ant;
-    }
+    maquina->interrupcoesAgendadas &= ~(0b1 << prioridade);
 }
 
-void executar_watchdog()
+void executar_watchdog(Poxim *maquina)
 {
-    if(contador == 0) {
-        watchdog = watchdog & 0;
-
-        if(verificar_flag_setada(IE)) {
-            fprintf(saida, "[HARDWARE INTERRUPTION 1]\n");
+    maquina->watchdog = maquina->watchdog & 0;
 
-            preparar_execucao_ISR();
-            R[CR] = 0xE1AC04DA;
-            R[IPC] = R[PC] + 4;
-            R[PC] = 0x10;
-            R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
-        } else {
-            agendar_interrupcao(1, 0xE1AC04DA, R[PC]);
-        }
+    if(verificar_flag_setada(maquina, IE)) {
+        registrar_interrupcao_hardware(maquina, 1);
 
-        return;
+        preparar_execucao_ISR(maquina);
+        maquina->R[CR] = 0xE1AC04DA;
+        maquina->R[IPC] = maquina->R[PC] + 4;
+        maquina->R[PC] = 0x10;
+        maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+    } else {
+        agendar_interrupcao(maquina, 1, 0xE1AC04DA, maquina->R[PC]);
     }
-
-    contador--;
 }
 
-void fpu_adicao()
+void fpu_adicao(Poxim *maquina)
 {
     uint8_t expoenteX, expoenteY;
 
-    fpuZ.f = fpuX.f + fpuY.f;
+    maquina->fpuZ.f = maquina->fpuX.f + maquina->fpuY.f;
 
-    expoenteX = (*(uint32_t *)&fpuX & (0b11111111 << 23)) >> 23;
-    expoenteY = (*(uint32_t *)&fpuY & (0b11111111 << 23)) >> 23;
+    expoenteX = (*(uint32_t *)&maquina->fpuX & (0b11111111 << 23)) >> 23;
+    expoenteY = (*(uint32_t *)&maquina->fpuY & (0b11111111 << 23)) >> 23;
 
-    fpu_preparar_interrupcao(3, abs(expoenteX - expoenteY) + 1);
+    fpu_preparar_interrupcao(maquina, 3, abs(expoenteX - expoenteY) + 1);
 }
 
-void fpu_subtracao()
+void fpu_subtracao(Poxim *maquina)
 {
     uint8_t expoenteX, expoenteY;
 
-    fpuZ.f = fpuX.f - fpuY.f;
+    maquina->fpuZ.f = maquina->fpuX.f - maquina->fpuY.f;
 
-    expoenteX = (*(uint32_t *)&fpuX & (0b11111111 << 23)) >> 23;
-    expoenteY = (*(uint32_t *)&fpuY & (0b11111111 << 23)) >> 23;
+    expoenteX = (*(uint32_t *)&maquina->fpuX & (0b11111111 << 23)) >> 23;
+    expoenteY = (*(uint32_t *)&maquina->fpuY & (0b11111111 << 23)) >> 23;
 
-    fpu_preparar_interrupcao(3, abs(expoenteX - expoenteY) + 1);
+    fpu_preparar_interrupcao(maquina, 3, abs(expoenteX - expoenteY) + 1);
 }
 
-void fpu_multiplicacao()
+void fpu_multiplicacao(Poxim *maquina)
 {
     uint8_t expoenteX, expoenteY;
 
-    fpuZ.f = fpuX.f * fpuY.f;
+    maquina->fpuZ.f = maquina->fpuX.f * maquina->fpuY.f;
 
-    expoenteX = (*(uint32_t *)&fpuX & (0b11111111 << 23)) >> 23;
-    expoenteY = (*(uint32_t *)&fpuY & (0b11111111 << 23)) >> 23;
+    expoenteX = (*(uint32_t *)&maquina->fpuX & (0b11111111 << 23)) >> 23;
+    expoenteY = (*(uint32_t *)&maquina->fpuY & (0b11111111 << 23)) >> 23;
 
-    fpu_preparar_interrupcao(3, abs(expoenteX - expoenteY) + 1);
+    fpu_preparar_interrupcao(maquina, 3, abs(expoenteX - expoenteY) + 1);
 }
 
-void fpu_divisao()
+void fpu_divisao(Poxim *maquina)
 {
     uint8_t expoenteX, expoenteY;
 
-    expoenteX = (*(uint32_t *)&fpuX & (0b11111111 << 23)) >> 23;
-    expoenteY = (*(uint32_t *)&fpuY & (0b11111111 << 23)) >> 23;
+    expoenteX = (*(uint32_t *)&maquina->fpuX & (0b11111111 << 23)) >> 23;
+    expoenteY = (*(uint32_t *)&maquina->fpuY & (0b11111111 << 23)) >> 23;
 
-    if(fpuY.f == 0) {
-        fpu_preparar_interrupcao(2, abs(expoenteX - expoenteY) + 1);
+    if(maquina->fpuY.f == 0) {
+        fpu_preparar_interrupcao(maquina, 2, abs(expoenteX - expoenteY) + 1);
 
         return;
     }
 
-    fpuZ.f = fpuX.f / fpuY.f;
+    maquina->fpuZ.f = maquina->fpuX.f / maquina->fpuY.f;
 
-    fpu_preparar_interrupcao(3, abs(expoenteX - expoenteY) + 1);
+    fpu_preparar_interrupcao(maquina, 3, abs(expoenteX - expoenteY) + 1);
 }
 
-void fpu_atribuicao_x()
+void fpu_atribuicao_x(Poxim *maquina)
 {
-    fpuX.f = fpuZ.f;
-    fpuX_IEEE754 = 1;
+    maquina->fpuX.f = maquina->fpuZ.f;
+    maquina->fpuX_IEEE754 = 1;
 
-    fpu_preparar_interrupcao(4, 1);
+    fpu_preparar_interrupcao(maquina, 4, 1);
 }
 
-void fpu_atribuicao_y()
+void fpu_atribuicao_y(Poxim *maquina)
 {
-    fpuY.f = fpuZ.f;
-    fpuY_IEEE754 = 1;
+    maquina->fpuY.f = maquina->fpuZ.f;
+    maquina->fpuY_IEEE754 = 1;
 
-    fpu_preparar_interrupcao(4, 1);
+    fpu_preparar_interrupcao(maquina, 4, 1);
 }
 
-void fpu_teto()
+void fpu_teto(Poxim *maquina)
 {
-    if(fpuZ_IEEE754)
-        fpuZ.f = (float)(int)fpuZ.f == fpuZ.f ? fpuZ.f : (int)fpuZ.f + 1;
+    if(maquina->fpuZ_IEEE754)
+        maquina->fpuZ.f = (float)(int)maquina->fpuZ.f == maquina->fpuZ.f ? maquina->fpuZ.f : (int)maquina->fpuZ.f + 1;
     else
-        fpuZ.u = (float)(int)fpuZ.f == fpuZ.f ? fpuZ.f : (int)fpuZ.f + 1;
+        maquina->fpuZ.u = (float)(int)maquina->fpuZ.f == maquina->fpuZ.f ? maquina->fpuZ.f : (int)maquina->fpuZ.f + 1;
 
-    fpuZ_IEEE754 = 0;
+    maquina->fpuZ_IEEE754 = 0;
 
-    fpu_preparar_interrupcao(4, 1);
+    fpu_preparar_interrupcao(maquina, 4, 1);
 }
 
-void fpu_piso()
+void fpu_piso(Poxim *maquina)
 {
-    if(fpuZ_IEEE754)
-        fpuZ.f = (int)fpuZ.f;
+    if(maquina->fpuZ_IEEE754)
+        maquina->fpuZ.f = (int)maquina->fpuZ.f;
     else
-        fpuZ.u = (int)fpuZ.f;
+        maquina->fpuZ.u = (int)maquina->fpuZ.f;
 
-    fpuZ_IEEE754 = 0;
+    maquina->fpuZ_IEEE754 = 0;
 
-    fpu_preparar_interrupcao(4, 1);
+    fpu_preparar_interrupcao(maquina, 4, 1);
 }
 
-void fpu_arredondamento()
+void fpu_arredondamento(Poxim *maquina)
 {
-    int piso = (int)fpuZ.f;
-    int teto = (float)piso == fpuZ.f ? piso : piso + 1;
+    int piso = (int)maquina->fpuZ.f;
+    int teto = (float)piso == maquina->fpuZ.f ? piso : piso + 1;
 
-    if(fpuZ.f - piso < teto - fpuZ.f) {
-        fpuZ.f = piso;
-    } else if(fpuZ.f - piso < teto - fpuZ.f) {
-        fpuZ.f = teto;
+    if(maquina->fpuZ.f - piso < teto - maquina->fpuZ.f) {
+        maquina->fpuZ.f = piso;
+    } else if(maquina->fpuZ.f - piso < teto - maquina->fpuZ.f) {
+        maquina->fpuZ.f = teto;
     } else {
         if(piso % 2 == 0)
-            fpuZ.f = piso;
+            maquina->fpuZ.f = piso;
         else
-            fpuZ.f = teto;
+            maquina->fpuZ.f = teto;
     }
 
-    fpuZ_IEEE754 = 0;
+    maquina->fpuZ_IEEE754 = 0;
 
-    fpu_preparar_interrupcao(4, 1);
+    fpu_preparar_interrupcao(maquina, 4, 1);
 }
 
-void fpu_interrupcao()
+void fpu_interrupcao(Poxim *maquina)
 {
-    if(verificar_flag_setada(IE)) {
-        preparar_execucao_ISR();
-        fprintf(saida, "[HARDWARE INTERRUPTION %u]\n", fpuPrioridade);
-        R[CR] = 0x01EEE754;
-        R[IPC] = pcAtual;
+    if(verificar_flag_setada(maquina, IE)) {
+        preparar_execucao_ISR(maquina);
+        registrar_interrupcao_hardware(maquina, maquina->fpuPrioridade);
+        maquina->R[CR] = 0x01EEE754;
+        maquina->R[IPC] = maquina->pcAtual;
 
-        switch(fpuPrioridade) {
+        switch(maquina->fpuPrioridade) {
             case 2:
-                R[PC] = 0x14;
+                maquina->R[PC] = 0x14;
                 // Seta o campo de status pra 1
-                fpuControle = fpuControle | (0b1 << 5);
+                maquina->fpuControle = maquina->fpuControle | (0b1 << 5);
                 break;
             case 3:
-                R[PC] = 0x18;
+                maquina->R[PC] = 0x18;
                 break;
             case 4:
-                R[PC] = 0x1C;
+                maquina->R[PC] = 0x1C;
                 break;
         }
 
-        R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
+        maquina->R[PC] -= 4; // Será incrementado no fim da instrução, comportamento padrão
 
         // Resetando a operação do registrador do FPU
-        fpuControle = fpuControle & (0b1 << 5);
+        maquina->fpuControle = maquina->fpuControle & (0b1 << 5);
     } else {
-        agendar_interrupcao(fpuPrioridade, 0x01EEE754, R[PC]);
+        agendar_interrupcao(maquina, maquina->fpuPrioridade, 0x01EEE754, maquina->R[PC]);
     }
 }
 
-void fpu_preparar_interrupcao(uint8_t prioridade, int contador)
+void fpu_preparar_interrupcao(Poxim *maquina, uint8_t prioridade, int contador)
 {
-    fpuContador = contador;
-    fpuPrioridade = prioridade;
+    maquina->fpuContador = contador;
+    maquina->fpuPrioridade = prioridade;
+
+    // A interrupção ocorre após uma instrução por ciclo de latência, contando a atual
+    agendar_evento(maquina, EVENTO_FPU_CONCLUSAO, maquina->instrucoesExecutadas + contador);
 }
 
-void executar_logica_fpu()
+void executar_logica_fpu(Poxim *maquina)
 {
-    if(fpuContador == 0)
-        fpu_interrupcao();
+    fpu_interrupcao(maquina);
 
-    fpuContador--;
+    maquina->fpuContador = -1;
+
+    // Sem o IE a operação permanece no registrador de controle e é executada de novo na instrução seguinte
+    agendar_evento(maquina, EVENTO_FPU_INICIO, maquina->instrucoesExecutadas + 1);
 }
 
-void decodificar_instrucao_fpu(uint8_t operacao)
+void decodificar_instrucao_fpu(Poxim *maquina, uint8_t operacao)
 {
     switch(operacao) {
         case 0b00001:
-            fpu_adicao();
+            fpu_adicao(maquina);
             break;
         case 0b00010:
-            fpu_subtracao();
+            fpu_subtracao(maquina);
             break;
         case 0b00011:
-            fpu_multiplicacao();
+            fpu_multiplicacao(maquina);
             break;
         case 0b00100:
-            fpu_divisao();
+            fpu_divisao(maquina);
             break;
         case 0b00101:
-            fpu_atribuicao_x();
+            fpu_atribuicao_x(maquina);
             break;
         case 0b00110:
-            fpu_atribuicao_y();
+            fpu_atribuicao_y(maquina);
             break;
         case 0b00111:
-            fpu_teto();
+            fpu_teto(maquina);
             break;
         case 0b01000:
-            fpu_piso();
+            fpu_piso(maquina);
             break;
         case 0b01001:
-            fpu_arredondamento();
+            fpu_arredondamento(maquina);
             break;
         default:
-            fpu_preparar_interrupcao(2, 1);
+            fpu_preparar_interrupcao(maquina, 2, 1);
+    }
+}
+
+void decodificar_instrucao(Poxim *maquina, InstrucaoDecodificada *decodificada, uint32_t pc)
+{
+    decodificar_palavra(decodificada, maquina->MEM[pc >> 2], pc);
+
+#ifdef SUPERINSTRUCOES
+    if(instalar_superinstrucao(maquina, decodificada, pc))
+        return;
+#endif
+
+#if !defined(BLOCOS_BASICOS) && !defined(PERFIL_SUPERINSTRUCOES)
+    // cmp/cmpi seguido de um desvio pelas flags da comparação: os dois são executados pelo mesmo tratador.
+    // Os blocos básicos não fundem, já que o código nativo chama os tratadores uma instrução por vez
+    if((decodificada->operacao == OP_CMP || decodificada->operacao == OP_CMPI) && !decodificada->usaSR &&
+        entradas_contiguas(pc, 2)) {
+        InstrucaoDecodificada seguinte;
+        decodificar_palavra(&seguinte, maquina->MEM[(pc >> 2) + 1], pc + 4);
+
+        if(desvio_fundivel(seguinte.operacao))
+            decodificada->executar = _cmp_desvio;
     }
+#endif
 }
 
-void decodificar_instrucao(uint8_t instrucao)
+void decodificar_palavra(InstrucaoDecodificada *decodificada, uint32_t ir, uint32_t pc)
 {
+    // Obtendo o código da operação (6 bits mais significativos)
+    uint8_t codOp = (ir & (0b111111 << 26)) >> 26;
+
     // Código de diferenciação para instruções com o mesmo código de operação
     uint8_t codDif;
 
-    switch(instrucao) {
+    // Campos de registradores, extraídos independentemente do formato da instrução
+    decodificada->ir = ir;
+    decodificada->z = (ir & (0b11111 << 21)) >> 21;
+    decodificada->x = (ir & (0b11111 << 16)) >> 16;
+    decodificada->y = (ir & (0b11111 << 11)) >> 11;
+    decodificada->v = (ir & (0b11111 << 6)) >> 6;
+    decodificada->l = ir & 0b11111;
+    decodificada->alvo = 0;
+
+    // Instruções dos tipos U e F que podem ter o SR como operando (por campo, mesmo que o campo seja imediato)
+    decodificada->usaSR = codOp < 0b101010 && (decodificada->z == SR || decodificada->x == SR ||
+        decodificada->y == SR || decodificada->v == SR || decodificada->l == SR);
+
+    // Imediato com extensão de sinal de acordo com o formato da instrução
+    if(codOp == 0b000000)
+        decodificada->imediato = ir & 0x1FFFFF;
+    else if(codOp == 0b000001)
+        decodificada->imediato = (ir & 0x100000) ? (ir & 0x1FFFFF) | 0xFFE00000 : ir & 0x1FFFFF;
+    else if(codOp == 0b111111)
+        decodificada->imediato = ir & 0x3FFFFFF;
+    else if(codOp >= 0b101010)
+        decodificada->imediato = (ir & 0x2000000) ? (ir & 0x3FFFFFF) | 0xFC000000 : ir & 0x3FFFFFF;
+    else
+        decodificada->imediato = (int16_t)(ir & 0xFFFF);
+
+    // Destino dos desvios e chamadas do tipo S, relativo à instrução seguinte
+    if(codOp >= 0b101010 && codOp <= 0b111001)
+        decodificada->alvo = pc + 4 + ((uint32_t)decodificada->imediato << 2);
+
+    switch(codOp) {
         case 0b000000:
-            _mov();
+            decodificada->operacao = OP_MOV;
             break;
         case 0b000001:
-            _movs();
+            decodificada->operacao = OP_MOVS;
             break;
         case 0b000010:
-            _add();
+            decodificada->operacao = OP_ADD;
             break;
         case 0b000011:
-            _sub();
+            decodificada->operacao = OP_SUB;
             break;
         case 0b000100:
-            codDif = (R[IR] & (0b111 << 8)) >> 8;
+            codDif = (ir & (0b111 << 8)) >> 8;
             switch(codDif) {
                 case 0b000:
-                    _mul();
+                    decodificada->operacao = OP_MUL;
                     break;
                 case 0b001:
-                    _sll();
+                    decodificada->operacao = OP_SLL;
                     break;
                 case 0b010:
-                    _muls();
+                    decodificada->operacao = OP_MULS;
                     break;
                 case 0b011:
-                    _sla();
+                    decodificada->operacao = OP_SLA;
                     break;
                 case 0b100:
-                    _div();
+                    decodificada->operacao = OP_DIV;
                     break;
                 case 0b101:
-                    _srl();
+                    decodificada->operacao = OP_SRL;
                     break;
                 case 0b110:
-                    _divs();
+                    decodificada->operacao = OP_DIVS;
                     break;
                 case 0b111:
-                    _sra();
+                    decodificada->operacao = OP_SRA;
                     break;
                 default:
-                    retornar_instrucao_invalida();
+                    decodificada->operacao = OP_INVALIDA;
             }
             break;
         case 0b000101:
-            _cmp();
+            decodificada->operacao = OP_CMP;
             break;
         case 0b000110:
-            _and();
+            decodificada->operacao = OP_AND;
             break;
         case 0b000111:
-            _or();
+            decodificada->operacao = OP_OR;
             break;
         case 0b001000:
-            _not();
+            decodificada->operacao = OP_NOT;
             break;
         case 0b001001:
-            _xor();
+            decodificada->operacao = OP_XOR;
             break;
         case 0b001010:
-            _push();
+            decodificada->operacao = OP_PUSH;
             break;
         case 0b001011:
-            _pop();
+            decodificada->operacao = OP_POP;
             break;
         case 0b010010:
-            _addi();
+            decodificada->operacao = OP_ADDI;
             break;
         case 0b010011:
-            _subi();
+            decodificada->operacao = OP_SUBI;
             break;
         case 0b010100:
-            _muli();
+            decodificada->operacao = OP_MULI;
             break;
         case 0b010101:
-            _divi();
+            decodificada->operacao = OP_DIVI;
             break;
         case 0b010110:
-            _modi();
+            decodificada->operacao = OP_MODI;
             break;
         case 0b010111:
-            _cmpi();
+            decodificada->operacao = OP_CMPI;
             break;
         case 0b011000:
-            _l8();
+            decodificada->operacao = OP_L8;
             break;
         case 0b011001:
-            _l16();
+            decodificada->operacao = OP_L16;
             break;
         case 0b011010:
-            _l32();
+            decodificada->operacao = OP_L32;
             break;
         case 0b011011:
-            _s8();
+            decodificada->operacao = OP_S8;
             break;
         case 0b011100:
-            _s16();
+            decodificada->operacao = OP_S16;
             break;
         case 0b011101:
-            _s32();
+            decodificada->operacao = OP_S32;
             break;
         case 0b011110:
-            _callf();
+            decodificada->operacao = OP_CALLF;
             break;
         case 0b011111:
-            _ret();
+            decodificada->operacao = OP_RET;
             break;
         case 0b100000:
-            _reti();
+            decodificada->operacao = OP_RETI;
             break;
         case 0b100001:
-            codDif = (R[IR] & 0b1);
+            codDif = (ir & 0b1);
             switch(codDif) {
                 case 0b0:
-                    _cbr();
+                    decodificada->operacao = OP_CBR;
                     break;
                 case 0b1:
-                    _sbr();
+                    decodificada->operacao = OP_SBR;
                     break;
                 default:
-                    retornar_instrucao_invalida();
+                    decodificada->operacao = OP_INVALIDA;
             }
             break;
         case 0b101010:
-            _bae();
+            decodificada->operacao = OP_BAE;
             break;
         case 0b101011:
-            _bat();
+            decodificada->operacao = OP_BAT;
             break;
         case 0b101100:
-            _bbe();
+            decodificada->operacao = OP_BBE;
             break;
         case 0b101101:
-            _bbt();
+            decodificada->operacao = OP_BBT;
             break;
         case 0b101110:
-            _beq();
+            decodificada->operacao = OP_BEQ;
             break;
         case 0b101111:
-            _bge();
+            decodificada->operacao = OP_BGE;
             break;
         case 0b110000:
-            _bgt();
+            decodificada->operacao = OP_BGT;
             break;
         case 0b110001:
-            _biv();
+            decodificada->operacao = OP_BIV;
             break;
         case 0b110010:
-            _ble();
+            decodificada->operacao = OP_BLE;
             break;
         case 0b110011:
-            _blt();
+            decodificada->operacao = OP_BLT;
             break;
         case 0b110100:
-            _bne();
+            decodificada->operacao = OP_BNE;
             break;
         case 0b110101:
-            _bni();
+            decodificada->operacao = OP_BNI;
             break;
         case 0b110110:
-            _bnz();
+            decodificada->operacao = OP_BNZ;
             break;
         case 0b110111:
-            _bun();
+            decodificada->operacao = OP_BUN;
             break;
         case 0b111000:
-            _bzd();
+            decodificada->operacao = OP_BZD;
             break;
         case 0b111001:
-            _calls();
+            decodificada->operacao = OP_CALLS;
             break;
         case 0b111111:
-            _int();
+            decodificada->operacao = OP_INT;
             break;
         default:
-            retornar_instrucao_invalida();
+            decodificada->operacao = OP_INVALIDA;
+    }
+
+    decodificada->executar = tratadores[decodificada->operacao];
+    decodificada->valida = 1;
+}
+
+void invalidar_instrucao_decodificada(Poxim *maquina, uint32_t indice)
+{
+    // Uma página ainda não alocada não tem instruções decodificadas
+    InstrucaoDecodificada *pagina = maquina->paginasInstrucoes[indice >> BITS_PAGINA_INSTRUCOES];
+
+    if(pagina)
+        pagina[indice & ((1u << BITS_PAGINA_INSTRUCOES) - 1)].valida = 0;
+
+#ifdef BLOCOS_BASICOS
+    // Escrita em código já traduzido: todos os blocos são descartados
+    if(indice < ENTRADAS_TABELA_BLOCOS && maquina->palavrasEmBlocos[indice]) {
+        maquina->geracaoBlocos++;
+        memset(maquina->palavrasEmBlocos, 0, ENTRADAS_TABELA_BLOCOS * sizeof(uint8_t));
     }
+#endif
 }
 
-void visualizar_memoria()
+void visualizar_memoria(Poxim *maquina)
 {
-    fprintf(debug, "Exibindo dados da memória...\n\n");
+    fprintf(maquina->debug, "Exibindo dados da memória...\n\n");
     for (int i = 0; i < 8192; i++) {
-        fprintf(debug, "0x%08X: 0x%08X", i * 4, MEM[i]);
+        fprintf(maquina->debug, "0x%08X: 0x%08X", i * 4, maquina->MEM[i]);
 
         if((i + 1) % 5 == 0)
-            fprintf(debug, "\n");
+            fprintf(maquina->debug, "\n");
         else
-            fprintf(debug, "\t\t");
+            fprintf(maquina->debug, "\t\t");
     }
 
-    fprintf(debug, "\n");
+    fprintf(maquina->debug, "\n");
 }
 
-void visualizar_registradores()
+void visualizar_registradores(Poxim *maquina)
 {
-    fprintf(debug, "Exibindo dados dos registradores...\n\n");
+    materializar_flags(maquina);
+
+    fprintf(maquina->debug, "Exibindo dados dos registradores...\n\n");
     for (int i = 0; i < 32; i++) {
-        fprintf(debug, "R[%d] = 0x%08x", i, R[i]);
+        fprintf(maquina->debug, "R[%d] = 0x%08x", i, maquina->R[i]);
 
         if((i + 1) % 5 == 0)
-            fprintf(debug, "\n");
+            fprintf(maquina->debug, "\n");
         else
-            fprintf(debug, "\t\t");
+            fprintf(maquina->debug, "\t\t");
     }
 
-    fprintf(debug, "\n");
-}
-
-char *str_upper(char *string)
-{
-    for (int i = 0; i < strlen(string); i++)
-        string[i] = toupper(string[i]);
-
-    return string;
+    fprintf(maquina->debug, "\n");
 }
 
 int64_t potencia(int base, int expoente)
@@ -2793,13 +8290,10 @@ int64_t potencia(int base, int expoente)
     return resultado;
 }
 
-void visualizar_interrupcoes_pendentes()
+void visualizar_interrupcoes_pendentes(Poxim *maquina)
 {
-    Interrupcao *atual = interrupcoesAgendadas;
-
-    while(atual) {
-        fprintf(debug, "Prioridade: %u\nCR: %u\nIPC: %u\n\n", atual->prioridade, atual->cr, atual->ipc);
-
-        atual = atual->prox;
-    }
+    for(uint8_t prioridade = 1; prioridade <= 4; prioridade++)
+        if(maquina->interrupcoesAgendadas & (0b1 << prioridade))
+            fprintf(maquina->debug, "Prioridade: %u\nCR: %u\nIPC: %u\n\n", prioridade,
+                maquina->tabelaInterrupcoes[prioridade].cr, maquina->tabelaInterrupcoes[prioridade].ipc);
 }
\ No newline at end of file
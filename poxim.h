@@ -0,0 +1,96 @@
+#ifndef POXIM_H
+#define POXIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Funções exportadas pela libpoxim; as demais funções do simulador ficam ocultas na biblioteca compartilhada
+#ifdef __GNUC__
+#define POXIM_API __attribute__((visibility("default")))
+#else
+#define POXIM_API
+#endif
+
+// Máquina simulada. Cada máquina tem todo o seu estado: máquinas distintas podem ser usadas ao mesmo tempo,
+// cada uma em sua thread, mas uma mesma máquina não deve ser usada por duas threads ao mesmo tempo
+typedef struct poxim Poxim;
+
+// Limite de poxim_run para executar até o fim da simulação (int 0)
+#define POXIM_SEM_LIMITE UINT64_MAX
+
+// Registradores com função especial (os demais, de 1 a 25, são de uso geral; R0 é sempre 0)
+#define POXIM_CR 26
+#define POXIM_IPC 27
+#define POXIM_IR 28
+#define POXIM_PC 29
+#define POXIM_SP 30
+#define POXIM_SR 31
+
+// Modos de trace do arquivo de saída, como as opções --trace da linha de comando
+typedef enum poxim_trace {
+    POXIM_TRACE_OFF,
+    POXIM_TRACE_TERMINAL,
+    POXIM_TRACE_FULL,
+    POXIM_TRACE_BINARY
+} PoximTrace;
+
+// Dispositivos mapeados em memória: o terminal (l8 em 0x8888888A, s8 em 0x8888888B), o watchdog
+// (l32/s32 em 0x80808080) e o FPU (l32/s32 de 0x80808880 a 0x8080888C, l8/s8 em 0x8080888F)
+typedef enum poxim_device {
+    POXIM_DEVICE_TERMINAL,
+    POXIM_DEVICE_WATCHDOG,
+    POXIM_DEVICE_FPU,
+    POXIM_TOTAL_DEVICES
+} PoximDevice;
+
+// Callbacks de acesso a um dispositivo, com o endereço acessado. Devolvem diferente de 0 se trataram o acesso,
+// substituindo o dispositivo do simulador, ou 0 para que o simulador o trate como de costume
+typedef int (*PoximDeviceRead)(void *contexto, uint32_t endereco, uint32_t *valor);
+typedef int (*PoximDeviceWrite)(void *contexto, uint32_t endereco, uint32_t valor);
+
+// Cria uma máquina sem arquivo de saída e com o trace desligado
+POXIM_API Poxim *poxim_create(void);
+
+// Finaliza a simulação (terminal, resumo e fim do trace no arquivo de saída, se houver) e libera a máquina
+POXIM_API void poxim_destroy(Poxim *maquina);
+
+// Arquivo de saída e modo de trace; só podem ser alterados antes da carga da imagem. Devolvem 0 ou -1 em erro
+POXIM_API int poxim_set_output(Poxim *maquina, const char *caminho);
+POXIM_API int poxim_set_trace(Poxim *maquina, PoximTrace modo);
+
+// Callbacks de um dispositivo (NULL para não interceptar leituras ou escritas). Devolve 0 ou -1 em erro
+POXIM_API int poxim_set_device(Poxim *maquina, PoximDevice dispositivo, PoximDeviceRead ler, PoximDeviceWrite escrever, void *contexto);
+
+// Carrega a imagem a partir do endereço 0 e inicia a simulação; uma única vez por máquina. A memória tem todo o
+// espaço de endereçamento de 32 bits (4GiB, ou 2^30 palavras), zerado fora da imagem. poxim_load_hex também
+// aceita as imagens binárias geradas por --pack. Devolvem 0 ou -1 em erro
+POXIM_API int poxim_load_image(Poxim *maquina, const uint32_t *palavras, uint32_t quantidade);
+POXIM_API int poxim_load_hex(Poxim *maquina, const char *caminho);
+
+// Executa até `limite` instruções, parando antes se a simulação terminar. Devolve as instruções executadas
+POXIM_API uint64_t poxim_run(Poxim *maquina, uint64_t limite);
+POXIM_API uint64_t poxim_step(Poxim *maquina);
+
+// Diferente de 0 enquanto a simulação não terminar
+POXIM_API int poxim_running(Poxim *maquina);
+
+// Total de instruções executadas desde a carga da imagem
+POXIM_API uint64_t poxim_instructions(Poxim *maquina);
+
+// Acesso aos registradores (0 a 31); escritas em R0 são ignoradas
+POXIM_API uint32_t poxim_get_register(Poxim *maquina, uint32_t indice);
+POXIM_API int poxim_set_register(Poxim *maquina, uint32_t indice, uint32_t valor);
+
+// Acesso às palavras da memória, após a carga da imagem, a partir de um endereço alinhado em 4 bytes. Escritas
+// descartam as instruções já decodificadas ou traduzidas dessas palavras. Devolvem 0 ou -1 se o intervalo sair da memória
+POXIM_API int poxim_read_memory(Poxim *maquina, uint32_t endereco, uint32_t *palavras, uint32_t quantidade);
+POXIM_API int poxim_write_memory(Poxim *maquina, uint32_t endereco, const uint32_t *palavras, uint32_t quantidade);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
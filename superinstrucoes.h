@@ -0,0 +1,258 @@
+// Gerado por --superinstructions a partir de 1 perfil(s); regenere em vez de editar
+// Cada superinstrução encadeia os tratadores das operações, avançando como o laço principal entre elas
+
+// 140 execuções
+void _super_addi_l8_cmpi_bne(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _addi(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_L8))
+        return;
+
+    _l8(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 2);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 3, OP_BNE))
+        return;
+
+    _bne(maquina, decodificada + 3);
+}
+
+// 27 execuções
+void _super_push_l8_cmpi_beq(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _push(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_L8))
+        return;
+
+    _l8(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 2);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 3, OP_BEQ))
+        return;
+
+    _beq(maquina, decodificada + 3);
+}
+
+// 18 execuções
+void _super_push_l32_mov_calls(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _push(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_L32))
+        return;
+
+    _l32(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_MOV))
+        return;
+
+    _mov(maquina, decodificada + 2);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 3, OP_CALLS))
+        return;
+
+    _calls(maquina, decodificada + 3);
+}
+
+// 4146 execuções
+void _super_l8_cmpi_beq(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _l8(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_BEQ))
+        return;
+
+    _beq(maquina, decodificada + 2);
+}
+
+// 4117 execuções
+void _super_s8_addi_bun(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _s8(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_ADDI))
+        return;
+
+    _addi(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_BUN))
+        return;
+
+    _bun(maquina, decodificada + 2);
+}
+
+// 140 execuções
+void _super_l8_cmpi_bne(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _l8(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_BNE))
+        return;
+
+    _bne(maquina, decodificada + 2);
+}
+
+// 140 execuções
+void _super_addi_l8_cmpi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _addi(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_L8))
+        return;
+
+    _l8(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 2);
+}
+
+// 27 execuções
+void _super_push_l8_cmpi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _push(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_L8))
+        return;
+
+    _l8(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 2);
+}
+
+// 26 execuções
+void _super_l32_mov_calls(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _l32(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_MOV))
+        return;
+
+    _mov(maquina, decodificada + 1);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 2, OP_CALLS))
+        return;
+
+    _calls(maquina, decodificada + 2);
+}
+
+// 4286 execuções
+void _super_l8_cmpi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _l8(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_CMPI))
+        return;
+
+    _cmpi(maquina, decodificada + 1);
+}
+
+// 4146 execuções
+void _super_cmpi_beq(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _cmpi(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_BEQ))
+        return;
+
+    _beq(maquina, decodificada + 1);
+}
+
+// 4118 execuções
+void _super_addi_bun(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _addi(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_BUN))
+        return;
+
+    _bun(maquina, decodificada + 1);
+}
+
+// 4118 execuções
+void _super_s8_addi(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _s8(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_ADDI))
+        return;
+
+    _addi(maquina, decodificada + 1);
+}
+
+// 162 execuções
+void _super_cmpi_bne(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _cmpi(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_BNE))
+        return;
+
+    _bne(maquina, decodificada + 1);
+}
+
+// 140 execuções
+void _super_addi_l8(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _addi(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_L8))
+        return;
+
+    _l8(maquina, decodificada + 1);
+}
+
+// 53 execuções
+void _super_l32_mov(Poxim *maquina, InstrucaoDecodificada *decodificada)
+{
+    _l32(maquina, decodificada);
+
+    if(!avancar_superinstrucao(maquina, decodificada + 1, OP_MOV))
+        return;
+
+    _mov(maquina, decodificada + 1);
+}
+
+const Superinstrucao TABELA_SUPERINSTRUCOES[] = {
+    {4, {OP_ADDI, OP_L8, OP_CMPI, OP_BNE}, _super_addi_l8_cmpi_bne},
+    {4, {OP_PUSH, OP_L8, OP_CMPI, OP_BEQ}, _super_push_l8_cmpi_beq},
+    {4, {OP_PUSH, OP_L32, OP_MOV, OP_CALLS}, _super_push_l32_mov_calls},
+    {3, {OP_L8, OP_CMPI, OP_BEQ}, _super_l8_cmpi_beq},
+    {3, {OP_S8, OP_ADDI, OP_BUN}, _super_s8_addi_bun},
+    {3, {OP_L8, OP_CMPI, OP_BNE}, _super_l8_cmpi_bne},
+    {3, {OP_ADDI, OP_L8, OP_CMPI}, _super_addi_l8_cmpi},
+    {3, {OP_PUSH, OP_L8, OP_CMPI}, _super_push_l8_cmpi},
+    {3, {OP_L32, OP_MOV, OP_CALLS}, _super_l32_mov_calls},
+    {2, {OP_L8, OP_CMPI}, _super_l8_cmpi},
+    {2, {OP_CMPI, OP_BEQ}, _super_cmpi_beq},
+    {2, {OP_ADDI, OP_BUN}, _super_addi_bun},
+    {2, {OP_S8, OP_ADDI}, _super_s8_addi},
+    {2, {OP_CMPI, OP_BNE}, _super_cmpi_bne},
+    {2, {OP_ADDI, OP_L8}, _super_addi_l8},
+    {2, {OP_L32, OP_MOV}, _super_l32_mov},
+    {0}
+};
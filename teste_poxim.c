@@ -0,0 +1,228 @@
+// Teste da libpoxim (make check): executa a imagem pela biblioteca e compara com a saída esperada
+// Uso: teste_poxim input.hex output.out saida-temporaria
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "poxim.h"
+
+// Mesmo nome de uma tabela interna do simulador: com os símbolos internos da biblioteca locais, não há conflito na ligação
+const char *tratadores = "teste_poxim";
+
+typedef struct terminal {
+    char *texto;
+    size_t tamanho;
+} Terminal;
+
+char *ler_arquivo(const char *, size_t *);
+Poxim *criar_maquina_teste(const char *, const char *, PoximTrace);
+int comparar_saida(const char *, const char *, size_t, const char *);
+int testar_passos(const char *, const char *, const char *, size_t);
+int testar_execucao(const char *, const char *, const char *, size_t);
+int testar_dispositivo(const char *, const char *, const char *, size_t);
+int escrever_terminal_teste(void *, uint32_t, uint32_t);
+
+char *ler_arquivo(const char *caminho, size_t *tamanho)
+{
+    FILE *arquivo = fopen(caminho, "rb");
+
+    if(!arquivo) {
+        fprintf(stderr, "Não foi possível abrir o arquivo: %s\n", caminho);
+        return NULL;
+    }
+
+    fseek(arquivo, 0, SEEK_END);
+    long total = ftell(arquivo);
+    rewind(arquivo);
+
+    char *conteudo = malloc(total + 1);
+
+    if(!conteudo || fread(conteudo, 1, total, arquivo) != (size_t)total) {
+        fprintf(stderr, "Não foi possível ler o arquivo: %s\n", caminho);
+        free(conteudo);
+        fclose(arquivo);
+        return NULL;
+    }
+
+    conteudo[total] = '\0';
+    *tamanho = total;
+    fclose(arquivo);
+
+    return conteudo;
+}
+
+Poxim *criar_maquina_teste(const char *imagem, const char *saida, PoximTrace modo)
+{
+    Poxim *maquina = poxim_create();
+
+    if(saida && poxim_set_output(maquina, saida)) {
+        poxim_destroy(maquina);
+        return NULL;
+    }
+
+    if(poxim_set_trace(maquina, modo) || poxim_load_hex(maquina, imagem)) {
+        poxim_destroy(maquina);
+        return NULL;
+    }
+
+    return maquina;
+}
+
+int comparar_saida(const char *esperado, const char *saida, size_t tamanhoEsperado, const char *teste)
+{
+    size_t tamanho;
+    char *obtido = ler_arquivo(saida, &tamanho);
+
+    if(!obtido)
+        return 0;
+
+    int iguais = tamanho == tamanhoEsperado && !memcmp(obtido, esperado, tamanho);
+
+    if(!iguais)
+        fprintf(stderr, "%s: a saída difere da esperada\n", teste);
+
+    free(obtido);
+
+    return iguais;
+}
+
+int testar_passos(const char *imagem, const char *saida, const char *esperado, size_t tamanhoEsperado)
+{
+    Poxim *maquina = criar_maquina_teste(imagem, saida, POXIM_TRACE_FULL);
+
+    if(!maquina)
+        return 0;
+
+    // Uma instrução por chamada, até o fim da simulação
+    uint64_t passos = 0;
+
+    while(poxim_running(maquina)) {
+        if(poxim_step(maquina) != 1) {
+            fprintf(stderr, "poxim_step: nenhuma instrução executada na instrução %llu\n", (unsigned long long)passos);
+            poxim_destroy(maquina);
+            return 0;
+        }
+
+        passos++;
+    }
+
+    int correto = passos == poxim_instructions(maquina) && !poxim_step(maquina);
+
+    if(!correto)
+        fprintf(stderr, "poxim_step: %llu passos para %llu instruções\n", (unsigned long long)passos, (unsigned long long)poxim_instructions(maquina));
+
+    poxim_destroy(maquina);
+
+    return comparar_saida(esperado, saida, tamanhoEsperado, "poxim_step") && correto;
+}
+
+int testar_execucao(const char *imagem, const char *saida, const char *esperado, size_t tamanhoEsperado)
+{
+    Poxim *maquina = criar_maquina_teste(imagem, saida, POXIM_TRACE_FULL);
+
+    if(!maquina)
+        return 0;
+
+    // Limite que não coincide com os eventos da imagem, para parar no meio dos blocos e das interrupções
+    const uint64_t LIMITE = 997;
+    int correto = 1;
+
+    while(poxim_running(maquina)) {
+        uint64_t antes = poxim_instructions(maquina);
+        uint64_t executadas = poxim_run(maquina, LIMITE);
+
+        if(executadas != poxim_instructions(maquina) - antes || (executadas != LIMITE && poxim_running(maquina)))
+            correto = 0;
+    }
+
+    if(!correto)
+        fprintf(stderr, "poxim_run: número de instruções executadas incorreto\n");
+
+    poxim_destroy(maquina);
+
+    return comparar_saida(esperado, saida, tamanhoEsperado, "poxim_run") && correto;
+}
+
+int escrever_terminal_teste(void *contexto, uint32_t endereco, uint32_t valor)
+{
+    Terminal *terminal = contexto;
+
+    if(endereco != 0x8888888B)
+        return 0;
+
+    terminal->texto[terminal->tamanho++] = (char)valor;
+
+    return 1;
+}
+
+int testar_dispositivo(const char *imagem, const char *saida, const char *esperado, size_t tamanhoEsperado)
+{
+    // O terminal esperado fica entre [TERMINAL] e a quebra de linha que o encerra
+    const char *inicio = strstr(esperado, "[TERMINAL]\n");
+    const char *fim = strstr(esperado, "\n[END OF SIMULATION]\n");
+
+    if(!inicio || !fim || fim < inicio) {
+        fprintf(stderr, "poxim_set_device: saída esperada sem terminal\n");
+        return 0;
+    }
+
+    inicio += strlen("[TERMINAL]\n");
+
+    Terminal terminal = {calloc(tamanhoEsperado + 1, 1), 0};
+    Poxim *maquina = criar_maquina_teste(imagem, saida, POXIM_TRACE_TERMINAL);
+
+    if(!maquina || poxim_set_device(maquina, POXIM_DEVICE_TERMINAL, NULL, escrever_terminal_teste, &terminal)) {
+        poxim_destroy(maquina);
+        free(terminal.texto);
+        return 0;
+    }
+
+    poxim_run(maquina, POXIM_SEM_LIMITE);
+    poxim_destroy(maquina);
+
+    int correto = terminal.tamanho == (size_t)(fim - inicio) && !memcmp(terminal.texto, inicio, terminal.tamanho);
+
+    if(!correto)
+        fprintf(stderr, "poxim_set_device: o terminal interceptado difere do esperado\n");
+
+    // O callback tratou as escritas: o terminal do simulador fica vazio
+    size_t tamanho;
+    char *obtido = ler_arquivo(saida, &tamanho);
+
+    if(!obtido || (terminal.tamanho && strstr(obtido, terminal.texto))) {
+        fprintf(stderr, "poxim_set_device: o simulador também escreveu no terminal\n");
+        correto = 0;
+    }
+
+    free(obtido);
+    free(terminal.texto);
+
+    return correto;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc != 4) {
+        fprintf(stderr, "Uso: %s input.hex output.out saida-temporaria\n", argv[0]);
+        return 2;
+    }
+
+    size_t tamanhoEsperado;
+    char *esperado = ler_arquivo(argv[2], &tamanhoEsperado);
+
+    if(!esperado)
+        return 2;
+
+    int falhas = 0;
+
+    falhas += !testar_passos(argv[1], argv[3], esperado, tamanhoEsperado);
+    falhas += !testar_execucao(argv[1], argv[3], esperado, tamanhoEsperado);
+    falhas += !testar_dispositivo(argv[1], argv[3], esperado, tamanhoEsperado);
+
+    free(esperado);
+
+    if(falhas)
+        fprintf(stderr, "%d teste(s) da libpoxim falharam\n", falhas);
+
+    return falhas != 0;
+}